@@ -1,46 +1,38 @@
 #include <iostream>
-#include <fstream>
 #include <string>
+#include <vector>
+#include <stdexcept>
+#include "day01.hpp"
+#include "../utils/mapped_file.hpp"
+
+const std::string FILE_NAME = "day01_input.txt";
 
 int main(int argc, char *argv[])
 {
-  std::ifstream input_file;
-
-  input_file.open("day01_input.txt");
+  std::vector<std::string> args(argv + 1, argv + argc);
+  size_t sketch_size = take_percentiles_flag(args);
+  std::string file_name = args.size() > 0 ? args[0] : FILE_NAME;
+  size_t num_threads = args.size() > 1 ? std::stoull(args[1]) : utils::get_thread_count();
+  size_t num_top_elves = args.size() > 2 ? std::max<size_t>(1, std::stoull(args[2])) : TOP_ELVES;
 
-  if (!input_file.good())
+  try
   {
-    input_file.close();
-    return 0;
-  }
+    // The input is mapped rather than read line by line, so that each thread can scan its own chunk of it in place.
+    utils::MappedFile input_file(file_name);
+    CalorieTotals totals = count_calories_parallel(input_file.view(), num_top_elves, num_threads, sketch_size);
 
-  std::string current_line;
-
-  bool is_first_elf = true;
-  unsigned int max_calorie = 0;
-  unsigned int current_elf_calorie = 0;
-  while (std::getline(input_file, current_line))
-  {
-    // std::cout << current_line;
-    if (current_line.size() <= 0)
+    std::cout << "Max calories:\t" << totals.max_calories << "\n";
+    std::cout << "Combined max calories:\t" << totals.top_calories_sum << "\n";
+    for (const Elf &elf : totals.top_elves)
     {
-      // The first elf is always the first max.
-      if (is_first_elf || current_elf_calorie > max_calorie)
-      {
-        max_calorie = current_elf_calorie;
-        is_first_elf = false;
-        std::cout << "Current max calorie:\t" << max_calorie << "\n";
-      }
-
-      current_elf_calorie = 0;
-    }
-    else
-    {
-      current_elf_calorie += std::stoi(current_line);
+      std::cout << "Elf " << elf.index + 1 << ":\t" << elf.calories << "\n";
     }
+    print_calorie_percentiles(totals);
+  }
+  catch (std::runtime_error &)
+  {
+    return 0;
   }
-
-  input_file.close();
 
   return 0;
-}
\ No newline at end of file
+}
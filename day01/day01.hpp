@@ -0,0 +1,477 @@
+#pragma once
+#include <iostream>
+#include <string>
+#include <string_view>
+#include <vector>
+#include <algorithm>
+#include <bit>
+#include <cstring>
+#include "../utils/text.hpp"
+#include "../utils/parallel.hpp"
+#include "../utils/simd.hpp"
+#include "../utils/mapped_file.hpp"
+#include "../utils/quantile_sketch.hpp"
+
+const size_t TOP_ELVES = 3; // The default number of top elves, as asked for by part 2.
+const size_t QUANTILE_SKETCH_SIZE = 200; // The accuracy of the elf total percentiles, when asked for. See `utils::QuantileSketch`.
+const std::string PERCENTILES_FLAG = "--percentiles";
+
+/// @brief An elf and the calories it carries.
+struct Elf
+{
+  unsigned int calories = 0;
+  size_t index = 0; // The elf's position in its input, counting from 0.
+  size_t shard = 0; // Which input the elf is in, when the data is sharded across several.
+};
+
+/// @brief Orders elves by calories, largest first. Ties go to the earlier elf, so that the winners do not depend on how the input was chunked.
+constexpr bool is_better_elf(const Elf &a, const Elf &b)
+{
+  if (a.calories != b.calories)
+  {
+    return a.calories > b.calories;
+  }
+  return a.shard != b.shard ? a.shard < b.shard : a.index < b.index;
+}
+
+/// @brief Keeps the best `capacity` elves seen so far, in O(capacity) memory no matter how many elves are added.
+class TopElves
+{
+  size_t capacity;
+  std::vector<Elf> elves; // A heap with the worst kept elf at the front.
+
+public:
+  constexpr TopElves(size_t capacity = TOP_ELVES) : capacity(capacity)
+  {
+    elves.reserve(capacity);
+  }
+
+  /// @brief Adds an elf, evicting the worst kept elf if there is no room for both.
+  constexpr void add(const Elf &elf)
+  {
+    if (elves.size() < capacity)
+    {
+      elves.push_back(elf);
+      std::push_heap(elves.begin(), elves.end(), is_better_elf);
+    }
+    else if (capacity > 0 && is_better_elf(elf, elves.front()))
+    {
+      std::pop_heap(elves.begin(), elves.end(), is_better_elf);
+      elves.back() = elf;
+      std::push_heap(elves.begin(), elves.end(), is_better_elf);
+    }
+  }
+
+  /// @brief Adds every elf kept by another set.
+  /// @param other The other set.
+  /// @param index_offset Added to the indices of the other set's elves, e.g. when they were counted from the start of a chunk.
+  constexpr void merge(const TopElves &other, size_t index_offset = 0)
+  {
+    for (const Elf &elf : other.elves)
+    {
+      add(Elf{elf.calories, elf.index + index_offset, elf.shard});
+    }
+  }
+
+  /// @return The kept elves, best first.
+  constexpr std::vector<Elf> get_sorted() const
+  {
+    std::vector<Elf> sorted = elves;
+    std::sort(sorted.begin(), sorted.end(), is_better_elf);
+    return sorted;
+  }
+};
+
+/// @brief The answers for both parts of day 1.
+struct CalorieTotals
+{
+  unsigned int max_calories = 0;                      // Part 1: the most calories carried by a single elf.
+  unsigned long long top_calories_sum = 0;            // Part 2: the combined calories of the top elves.
+  std::vector<Elf> top_elves;                         // The top elves, best first.
+  size_t num_elves = 0;                               // The number of elves in the input.
+  utils::QuantileSketch<unsigned int> calorie_sketch; // The distribution of every elf's total, for percentiles.
+};
+
+/// @brief What a scan over one chunk of the input finds. The elves at either end of a chunk may continue into the neighbouring
+/// chunks, so their calories are kept apart until the chunks are stitched back together.
+struct CalorieChunk
+{
+  unsigned int leading_calories = 0;                  // Calories before the first blank line, or in the whole chunk if there is none.
+  unsigned int trailing_calories = 0;                 // Calories after the last blank line.
+  bool has_leading = false;                           // Whether there is at least one number before the first blank line.
+  bool has_trailing = false;                          // Whether there is at least one number after the last blank line.
+  bool has_separator = false;                         // Whether the chunk has a blank line at all.
+  size_t num_elves = 0;                               // The number of elves that start and end within the chunk.
+  TopElves top_elves;                                 // The best of those elves, indexed from the first of them.
+  utils::QuantileSketch<unsigned int> calorie_sketch; // The distribution of those elves' totals.
+};
+
+/// @brief Keeps track of the elf being summed while a chunk is scanned, and of the partial elves at either end of the chunk.
+struct CalorieScanner
+{
+  CalorieChunk result{};
+  unsigned int current_elf_calorie = 0;
+  bool has_current_elf = false;
+
+  /// @param num_top_elves The number of top elves to keep.
+  /// @param sketch_size The size of the quantile sketch of elf totals, or 0 to skip it.
+  constexpr CalorieScanner(size_t num_top_elves, size_t sketch_size = 0)
+  {
+    result.top_elves = TopElves(num_top_elves);
+    result.calorie_sketch = utils::QuantileSketch<unsigned int>(sketch_size);
+  }
+
+  /// @brief Adds one line's calories to the current elf.
+  constexpr void add_calories(unsigned int calories)
+  {
+    current_elf_calorie += calories;
+    has_current_elf = true;
+  }
+
+  /// @brief Closes the current elf at a blank line.
+  constexpr void add_separator()
+  {
+    if (!result.has_separator)
+    {
+      result.leading_calories = current_elf_calorie;
+      result.has_leading = has_current_elf;
+      result.has_separator = true;
+    }
+    else if (has_current_elf)
+    {
+      result.top_elves.add(Elf{current_elf_calorie, result.num_elves++});
+      result.calorie_sketch.add(current_elf_calorie);
+    }
+    current_elf_calorie = 0;
+    has_current_elf = false;
+  }
+
+  /// @brief Stores the elf that is still open at the end of the chunk.
+  /// @return The chunk's result.
+  constexpr CalorieChunk finish()
+  {
+    if (!result.has_separator)
+    {
+      result.leading_calories = current_elf_calorie;
+      result.has_leading = has_current_elf;
+    }
+    else
+    {
+      result.trailing_calories = current_elf_calorie;
+      result.has_trailing = has_current_elf;
+    }
+    return result;
+  }
+};
+
+/// @brief Counts the calories in one chunk of the input, which must start at the beginning of a line.
+/// @param chunk The chunk.
+/// @param num_top_elves The number of top elves to keep.
+/// @param sketch_size The size of the quantile sketch of elf totals, or 0 to skip it.
+/// @return The elves found within the chunk, and the partial elves at either end of it.
+constexpr CalorieChunk count_chunk_calories(std::string_view chunk, size_t num_top_elves = TOP_ELVES, size_t sketch_size = 0)
+{
+  CalorieScanner scanner(num_top_elves, sketch_size);
+  while (!chunk.empty())
+  {
+    std::string_view line = utils::next_line(chunk);
+    if (line.empty())
+    {
+      scanner.add_separator();
+    }
+    else
+    {
+      size_t i = 0;
+      scanner.add_calories((unsigned int)utils::parse_unsigned(line, i));
+    }
+  }
+  return scanner.finish();
+}
+
+/// @brief Adds a line of a chunk to the scanner.
+/// @param scanner The scanner.
+/// @param chunk The chunk, which tells how many bytes can be read past the line.
+/// @param line The line, without its line ending.
+void scan_calorie_line(CalorieScanner &scanner, std::string_view chunk, std::string_view line)
+{
+  size_t readable = chunk.data() + chunk.size() - line.data(); // The line and everything after it in the chunk.
+
+  if (line.empty())
+  {
+    scanner.add_separator();
+  }
+  else if (line.size() <= 8 && readable >= 8)
+  {
+    scanner.add_calories(utils::parse_digits_swar(line.data(), line.size()));
+  }
+  else if (line.size() <= 8)
+  {
+    char padded[8] = {};
+    std::memcpy(padded, line.data(), line.size());
+    scanner.add_calories(utils::parse_digits_swar(padded, line.size()));
+  }
+  else
+  {
+    size_t i = 0;
+    scanner.add_calories((unsigned int)utils::parse_unsigned(line, i));
+  }
+}
+
+/// @brief Adds every line of a chunk to the scanner. Finds the line breaks 64 bytes at a time with `utils::for_each_line` and
+/// converts each line's digits at once, so that it only branches per line instead of per character. Lines must be plain numbers.
+/// @param scanner The scanner.
+/// @param chunk The chunk, which must start at the beginning of a line.
+void scan_calorie_lines_simd(CalorieScanner &scanner, std::string_view chunk)
+{
+  utils::for_each_line(chunk, [&](std::string_view line)
+                       { scan_calorie_line(scanner, chunk, line); });
+}
+
+/// @brief Does the same as `count_chunk_calories`, but with `scan_calorie_lines_simd`.
+/// @param chunk The chunk.
+/// @param num_top_elves The number of top elves to keep.
+/// @param sketch_size The size of the quantile sketch of elf totals, or 0 to skip it.
+/// @return The elves found within the chunk, and the partial elves at either end of it.
+CalorieChunk count_chunk_calories_simd(std::string_view chunk, size_t num_top_elves = TOP_ELVES, size_t sketch_size = 0)
+{
+  CalorieScanner scanner(num_top_elves, sketch_size);
+  scan_calorie_lines_simd(scanner, chunk);
+  return scanner.finish();
+}
+
+/// @brief Turns the top elves into the answers.
+/// @param top_elves The top elves over the whole input.
+/// @param num_elves The number of elves in the input.
+/// @param calorie_sketch The distribution of every elf's total.
+/// @return The answers.
+constexpr CalorieTotals make_calorie_totals(const TopElves &top_elves, size_t num_elves, const utils::QuantileSketch<unsigned int> &calorie_sketch)
+{
+  CalorieTotals totals{};
+  totals.calorie_sketch = calorie_sketch;
+  totals.top_elves = top_elves.get_sorted();
+  totals.num_elves = num_elves;
+  totals.max_calories = totals.top_elves.empty() ? 0 : totals.top_elves[0].calories;
+  for (const Elf &elf : totals.top_elves)
+  {
+    totals.top_calories_sum += elf.calories;
+  }
+  return totals;
+}
+
+/// @brief Joins the partial elves of consecutive chunks, and merges every chunk's top elves.
+/// @param chunks The chunk results, in input order.
+/// @param num_chunks The number of chunks.
+/// @param num_top_elves The number of top elves to keep. Must match the chunks'.
+/// @return The maximum and the top elves over the whole input.
+constexpr CalorieTotals stitch_calorie_chunks(const CalorieChunk *chunks, size_t num_chunks, size_t num_top_elves = TOP_ELVES)
+{
+  TopElves top_elves(num_top_elves);
+  utils::QuantileSketch<unsigned int> calorie_sketch(num_chunks > 0 ? chunks[0].calorie_sketch.get_k() : 0);
+  size_t num_elves = 0;
+  unsigned int straddling_calories = 0; // The elf that is still open at the end of the previous chunk.
+  bool has_straddling_elf = false;
+
+  for (size_t i = 0; i < num_chunks; i++)
+  {
+    const CalorieChunk &chunk = chunks[i];
+    straddling_calories += chunk.leading_calories;
+    has_straddling_elf = has_straddling_elf || chunk.has_leading;
+    if (!chunk.has_separator)
+    {
+      continue; // The elf spans the whole chunk.
+    }
+
+    if (has_straddling_elf)
+    {
+      top_elves.add(Elf{straddling_calories, num_elves++});
+      calorie_sketch.add(straddling_calories);
+    }
+    top_elves.merge(chunk.top_elves, num_elves);
+    calorie_sketch.merge(chunk.calorie_sketch);
+    num_elves += chunk.num_elves;
+    straddling_calories = chunk.trailing_calories;
+    has_straddling_elf = chunk.has_trailing;
+  }
+  if (has_straddling_elf)
+  {
+    top_elves.add(Elf{straddling_calories, num_elves++}); // The last elf is not followed by a blank line.
+    calorie_sketch.add(straddling_calories);
+  }
+
+  return make_calorie_totals(top_elves, num_elves, calorie_sketch);
+}
+
+/// @brief Counts the calories carried by each elf in a single pass. Usable in constant expressions.
+/// @param input The puzzle input: one number per line, with elves separated by blank lines.
+/// @param num_top_elves The number of top elves to keep.
+/// @param sketch_size The size of the quantile sketch of elf totals, or 0 to skip it.
+/// @return The maximum and the top elves.
+constexpr CalorieTotals count_calories(std::string_view input, size_t num_top_elves = TOP_ELVES, size_t sketch_size = 0)
+{
+  CalorieChunk chunk = count_chunk_calories(input, num_top_elves, sketch_size);
+  return stitch_calorie_chunks(&chunk, 1, num_top_elves);
+}
+
+/// @brief Counts the calories carried by each elf, with each thread scanning its own chunk of the input with `count_chunk_calories_simd`.
+/// @param input The puzzle input, e.g. the view of a `utils::MappedFile`.
+/// @param num_top_elves The number of top elves to keep.
+/// @param num_threads The most threads to use.
+/// @param sketch_size The size of the quantile sketch of elf totals, or 0 to skip it.
+/// @return The maximum and the top elves.
+CalorieTotals count_calories_parallel(std::string_view input, size_t num_top_elves = TOP_ELVES, size_t num_threads = utils::get_thread_count(),
+                                      size_t sketch_size = 0)
+{
+  size_t num_chunks = utils::get_chunk_count(input.size(), num_threads);
+  std::vector<std::string_view> chunks = utils::split_into_line_chunks(input, num_chunks);
+  std::vector<CalorieChunk> results(chunks.size());
+
+  utils::parallel_for(
+      chunks.size(), [&](size_t begin, size_t end, size_t)
+      {
+        for (size_t i = begin; i < end; i++)
+        {
+          results[i] = count_chunk_calories_simd(chunks[i], num_top_elves, sketch_size);
+        } },
+      chunks.size());
+
+  return stitch_calorie_chunks(results.data(), results.size(), num_top_elves);
+}
+
+/// @brief Takes the percentiles flag out of the command line arguments. The quantile sketch costs more than half of the scanning
+/// throughput, so the drivers only keep one when asked to.
+/// @param args The command line arguments, without the program name. The flag is removed, so the rest can be read by position.
+/// @return The quantile sketch size to use: `QUANTILE_SKETCH_SIZE` if the flag was given, or 0 to skip the sketch.
+size_t take_percentiles_flag(std::vector<std::string> &args)
+{
+  auto flag = std::find(args.begin(), args.end(), PERCENTILES_FLAG);
+  if (flag == args.end())
+  {
+    return 0;
+  }
+  args.erase(flag);
+  return QUANTILE_SKETCH_SIZE;
+}
+
+/// @brief Prints the percentiles of the elf totals, with the most their ranks can be off by.
+/// @param totals The answers.
+void print_calorie_percentiles(const CalorieTotals &totals)
+{
+  if (!totals.calorie_sketch.is_enabled())
+  {
+    return;
+  }
+  std::cout << "p50 calories:\t" << totals.calorie_sketch.get_quantile(0.5) << "\n";
+  std::cout << "p99 calories:\t" << totals.calorie_sketch.get_quantile(0.99) << "\n";
+  std::cout << "p99.9 calories:\t" << totals.calorie_sketch.get_quantile(0.999) << "\n";
+  std::cout << "Rank error:\t+/-" << totals.calorie_sketch.get_rank_error() * 100 << "%\n";
+}
+
+/// @brief Counts the calories in inputs that are sharded across several files. Each thread maps and scans whole shards and keeps
+/// one set of top elves for all of them, so memory stays O(`num_top_elves` × threads) however many shards there are.
+/// @param file_names The shards. An elf's `shard` is the index of its file here.
+/// @param num_top_elves The number of top elves to keep.
+/// @param num_threads The most threads to use.
+/// @param sketch_size The size of the quantile sketch of elf totals, or 0 to skip it.
+/// @return The maximum and the top elves over every shard. `num_elves` counts the elves of every shard.
+CalorieTotals count_sharded_calories(const std::vector<std::string> &file_names, size_t num_top_elves = TOP_ELVES,
+                                     size_t num_threads = utils::get_thread_count(), size_t sketch_size = 0)
+{
+  num_threads = std::max<size_t>(1, std::min(num_threads, file_names.size()));
+  std::vector<TopElves> thread_top_elves(num_threads, TopElves(num_top_elves));
+  std::vector<utils::QuantileSketch<unsigned int>> thread_sketches(num_threads, utils::QuantileSketch<unsigned int>(sketch_size));
+  std::vector<size_t> thread_num_elves(num_threads);
+
+  utils::parallel_for(
+      file_names.size(), [&](size_t begin, size_t end, size_t thread_idx)
+      {
+        for (size_t i = begin; i < end; i++)
+        {
+          utils::MappedFile input_file(file_names[i]);
+          CalorieChunk chunk = count_chunk_calories_simd(input_file.view(), num_top_elves, sketch_size);
+          CalorieTotals shard_totals = stitch_calorie_chunks(&chunk, 1, num_top_elves);
+          for (const Elf &elf : shard_totals.top_elves)
+          {
+            thread_top_elves[thread_idx].add(Elf{elf.calories, elf.index, i});
+          }
+          thread_num_elves[thread_idx] += shard_totals.num_elves;
+          thread_sketches[thread_idx].merge(shard_totals.calorie_sketch);
+        } },
+      num_threads);
+
+  TopElves top_elves(num_top_elves);
+  utils::QuantileSketch<unsigned int> calorie_sketch(sketch_size);
+  size_t num_elves = 0;
+  for (size_t i = 0; i < num_threads; i++)
+  {
+    top_elves.merge(thread_top_elves[i]);
+    calorie_sketch.merge(thread_sketches[i]);
+    num_elves += thread_num_elves[i];
+  }
+  return make_calorie_totals(top_elves, num_elves, calorie_sketch);
+}
+
+/// @brief Counts the calories in an append-only input as it grows. Only the newly appended bytes are scanned on each update,
+/// so an update costs time in proportion to what was appended rather than to the size of the whole input.
+class CalorieFollower
+{
+  size_t num_top_elves;
+  size_t sketch_size;
+  size_t offset = 0;   // How many bytes of the input have been seen.
+  std::string pending;  // The last, unfinished line, which may still be being written.
+  CalorieScanner scanner;
+
+public:
+  CalorieFollower(size_t num_top_elves = TOP_ELVES, size_t sketch_size = 0)
+      : num_top_elves(num_top_elves), sketch_size(sketch_size), scanner(num_top_elves, sketch_size) {}
+
+  /// @return How many bytes of the input have been seen.
+  size_t get_offset() const
+  {
+    return offset;
+  }
+
+  /// @brief Scans bytes appended to the input. Only whole lines are counted; an unfinished line is held back until its line break arrives.
+  /// @param appended The bytes after `get_offset()`.
+  void feed(std::string_view appended)
+  {
+    offset += appended.size();
+    size_t last_line_break = appended.rfind('\n');
+    if (last_line_break == std::string_view::npos)
+    {
+      pending.append(appended);
+      return;
+    }
+
+    std::string_view complete_lines = appended.substr(0, last_line_break + 1);
+    std::string joined;
+    if (!pending.empty())
+    {
+      joined = pending;
+      joined.append(complete_lines);
+      complete_lines = joined;
+    }
+    scan_calorie_lines_simd(scanner, complete_lines);
+    pending = appended.substr(last_line_break + 1);
+  }
+
+  /// @brief Gets the answers as if the input ended here. The elf being summed counts, and so does an unfinished line.
+  /// @return The maximum and the top elves so far.
+  CalorieTotals get_totals() const
+  {
+    CalorieScanner snapshot = scanner;
+    if (!pending.empty())
+    {
+      scan_calorie_lines_simd(snapshot, pending);
+    }
+    CalorieChunk chunk = snapshot.finish();
+    return stitch_calorie_chunks(&chunk, 1, num_top_elves);
+  }
+
+  /// @brief Forgets everything, e.g. after the input was truncated.
+  void reset()
+  {
+    offset = 0;
+    pending.clear();
+    scanner = CalorieScanner(num_top_elves, sketch_size);
+  }
+};
@@ -0,0 +1,78 @@
+//-------------------------------------------------------------------------------------------------
+// Day 01: Calorie Counting (throughput benchmark)
+// by Rene Jotham C. Culaway
+//
+// Times the original `std::getline` + `std::stoi` loop against the scalar and SIMD chunk scanners
+// on the same input, checks that they agree, and reports each one's throughput in GB/s.
+//-------------------------------------------------------------------------------------------------
+
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <stdexcept>
+#include "day01.hpp"
+#include "../utils/mapped_file.hpp"
+#include "../utils/benchmark.hpp"
+
+const std::string FILE_NAME = "day01_input.txt";
+const size_t DEFAULT_REPETITIONS = 5;
+
+/// @brief The original day 1 loop, reading from memory so that only the parsing is timed.
+/// @param input The puzzle input.
+/// @return The most calories carried by a single elf.
+unsigned int count_max_calories_getline(std::string_view input)
+{
+  std::istringstream input_stream{std::string(input)};
+  std::string current_line;
+  unsigned int max_calorie = 0;
+  unsigned int current_elf_calorie = 0;
+  while (std::getline(input_stream, current_line))
+  {
+    if (current_line.size() <= 0)
+    {
+      max_calorie = std::max(max_calorie, current_elf_calorie);
+      current_elf_calorie = 0;
+    }
+    else
+    {
+      current_elf_calorie += std::stoi(current_line);
+    }
+  }
+  return std::max(max_calorie, current_elf_calorie);
+}
+
+int main(int argc, char *argv[])
+{
+  std::string file_name = argc > 1 ? argv[1] : FILE_NAME;
+  size_t repetitions = argc > 2 ? std::stoull(argv[2]) : DEFAULT_REPETITIONS;
+
+  try
+  {
+    utils::MappedFile input_file(file_name);
+    std::string_view input = input_file.view();
+
+    unsigned int expected = utils::report_throughput("getline + stoi", input.size(), repetitions, [&]()
+                                                     { return count_max_calories_getline(input); });
+    unsigned int scalar = utils::report_throughput("scalar scan", input.size(), repetitions, [&]()
+                                                   { return count_calories(input).max_calories; });
+    unsigned int simd = utils::report_throughput("SIMD scan", input.size(), repetitions, [&]()
+                                                 {
+                                                   CalorieChunk chunk = count_chunk_calories_simd(input);
+                                                   return stitch_calorie_chunks(&chunk, 1).max_calories; });
+    unsigned int parallel = utils::report_throughput("SIMD scan, all threads", input.size(), repetitions, [&]()
+                                                     { return count_calories_parallel(input).max_calories; });
+
+    std::cout << "Max calories:\t" << expected << "\n";
+    if (scalar != expected || simd != expected || parallel != expected)
+    {
+      std::cout << "MISMATCH\n";
+      return 1;
+    }
+  }
+  catch (std::runtime_error &)
+  {
+    return 0;
+  }
+
+  return 0;
+}
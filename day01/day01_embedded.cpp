@@ -0,0 +1,30 @@
+//-------------------------------------------------------------------------------------------------
+// Day 01: Calorie Counting (compile-time)
+// by Rene Jotham C. Culaway
+//
+// Solves an embedded input entirely at compile time. Generate `input.embedded.hpp` with
+// `embed_input input.txt input.embedded.hpp`, then build with `-DEXPECTED_PART_1=<answer>` and
+// `-DEXPECTED_PART_2=<answer>` to have the answers checked by `static_assert`.
+//-------------------------------------------------------------------------------------------------
+
+#include <iostream>
+#include "day01.hpp"
+#include "input.embedded.hpp"
+
+// The totals hold a vector, which cannot outlive constant evaluation, so only the answers are kept.
+constexpr unsigned int MAX_CALORIES = count_calories(EMBEDDED_INPUT, TOP_ELVES, 0).max_calories;
+constexpr unsigned long long TOP_CALORIES_SUM = count_calories(EMBEDDED_INPUT, TOP_ELVES, 0).top_calories_sum;
+
+#ifdef EXPECTED_PART_1
+static_assert(MAX_CALORIES == EXPECTED_PART_1, "Part 1 does not match the expected answer.");
+#endif
+#ifdef EXPECTED_PART_2
+static_assert(TOP_CALORIES_SUM == EXPECTED_PART_2, "Part 2 does not match the expected answer.");
+#endif
+
+int main(int argc, char *argv[])
+{
+  std::cout << "Max calories:\t" << MAX_CALORIES << "\n";
+  std::cout << "Combined max calories:\t" << TOP_CALORIES_SUM << "\n";
+  return 0;
+}
@@ -0,0 +1,81 @@
+//-------------------------------------------------------------------------------------------------
+// Day 01: Calorie Counting (follow mode)
+// by Rene Jotham C. Culaway
+//
+// Watches an append-only calorie log, like `tail -f`. The file is polled for new bytes, only those
+// are scanned, and the answers are printed again whenever new bytes arrive. If the file shrinks, it is
+// assumed to have been replaced and is read again from the start.
+//-------------------------------------------------------------------------------------------------
+
+#include <chrono>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <string>
+#include <thread>
+#include <vector>
+#include "day01.hpp"
+
+const std::string FILE_NAME = "day01_input.txt";
+const size_t DEFAULT_POLL_MILLISECONDS = 250;
+
+/// @brief Reads the bytes of a file from an offset up to its current end.
+/// @param file_name The file.
+/// @param offset The offset to start at.
+/// @return The bytes, or nothing if the file could not be read.
+std::string read_appended(const std::string &file_name, size_t offset)
+{
+  std::ifstream input_file(file_name, std::ios::binary);
+  if (!input_file.good())
+  {
+    return "";
+  }
+  input_file.seekg(0, std::ios::end);
+  size_t size = (size_t)input_file.tellg();
+  if (size <= offset)
+  {
+    return "";
+  }
+
+  std::string appended(size - offset, '\0');
+  input_file.seekg(offset);
+  input_file.read(appended.data(), appended.size());
+  appended.resize(input_file.gcount());
+  return appended;
+}
+
+int main(int argc, char *argv[])
+{
+  std::vector<std::string> args(argv + 1, argv + argc);
+  size_t sketch_size = take_percentiles_flag(args);
+  std::string file_name = args.size() > 0 ? args[0] : FILE_NAME;
+  size_t poll_milliseconds = args.size() > 1 ? std::stoull(args[1]) : DEFAULT_POLL_MILLISECONDS;
+  size_t num_top_elves = args.size() > 2 ? std::max<size_t>(1, std::stoull(args[2])) : TOP_ELVES;
+
+  CalorieFollower follower(num_top_elves, sketch_size);
+  while (true)
+  {
+    std::error_code error;
+    size_t size = std::filesystem::file_size(file_name, error);
+    if (!error && size < follower.get_offset())
+    {
+      follower.reset();
+    }
+
+    std::string appended = read_appended(file_name, follower.get_offset());
+    if (!appended.empty())
+    {
+      follower.feed(appended);
+      CalorieTotals totals = follower.get_totals();
+      std::cout << "Bytes read:\t" << follower.get_offset() << "\n";
+      std::cout << "Max calories:\t" << totals.max_calories << "\n";
+      std::cout << "Combined max calories:\t" << totals.top_calories_sum << "\n";
+      print_calorie_percentiles(totals);
+      std::cout << std::flush;
+    }
+
+    std::this_thread::sleep_for(std::chrono::milliseconds(poll_milliseconds));
+  }
+
+  return 0;
+}
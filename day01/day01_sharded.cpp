@@ -0,0 +1,47 @@
+//-------------------------------------------------------------------------------------------------
+// Day 01: Calorie Counting (sharded inputs)
+// by Rene Jotham C. Culaway
+//
+// Solves calorie data that is split across several files, one per producer, with the shards spread
+// over the worker threads. Usage: `day01_sharded [--percentiles] <top elves> <shard>...`. Each winning
+// elf is named by its shard and its position within that shard.
+//-------------------------------------------------------------------------------------------------
+
+#include <iostream>
+#include <string>
+#include <stdexcept>
+#include <vector>
+#include "day01.hpp"
+
+int main(int argc, char *argv[])
+{
+  std::vector<std::string> args(argv + 1, argv + argc);
+  size_t sketch_size = take_percentiles_flag(args);
+  if (args.size() < 2)
+  {
+    std::cout << "Usage: " << argv[0] << " [" << PERCENTILES_FLAG << "] <top elves> <shard>...\n";
+    return 0;
+  }
+  size_t num_top_elves = std::max<size_t>(1, std::stoull(args[0]));
+  std::vector<std::string> file_names(args.begin() + 1, args.end());
+
+  try
+  {
+    CalorieTotals totals = count_sharded_calories(file_names, num_top_elves, utils::get_thread_count(), sketch_size);
+
+    std::cout << "Max calories:\t" << totals.max_calories << "\n";
+    std::cout << "Combined max calories:\t" << totals.top_calories_sum << "\n";
+    for (const Elf &elf : totals.top_elves)
+    {
+      std::cout << file_names[elf.shard] << ", elf " << elf.index + 1 << ":\t" << elf.calories << "\n";
+    }
+    print_calorie_percentiles(totals);
+  }
+  catch (std::runtime_error &error)
+  {
+    std::cout << error.what() << "\n";
+    return 0;
+  }
+
+  return 0;
+}
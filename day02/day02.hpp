@@ -0,0 +1,449 @@
+#pragma once
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <cstring>
+#include <string_view>
+#include "../utils/text.hpp"
+#include "../utils/parallel.hpp"
+
+#if defined(__AVX2__) || defined(__SSE2__)
+#include <immintrin.h>
+#endif
+
+#if defined(__AVX2__)
+using RoundVector = __m256i;
+#elif defined(__SSE2__)
+using RoundVector = __m128i;
+#endif
+
+// The scorer is generic over cyclic games with any odd number of shapes N, like rock paper scissors (3) or rock paper scissors
+// spock lizard (5). Shape i beats shape j when (i - j) mod N is odd, so every shape beats half of the others and loses to the
+// other half. Actions are the letters from 'A' and responses the letters up to 'Z' (X to Z for 3 shapes, V to Z for 5).
+// When the responses are results, X, Y and Z always mean lose, draw and win, whatever N is.
+// Every table is built at compile time for each N, so a new variant only needs its own instantiation; scoring is still a table
+// lookup per kind of round.
+
+const size_t NUM_SHAPES = 3;  // The puzzle's game.
+const size_t NUM_RESULTS = 3; // Lose, draw and win.
+const size_t RECORD_SIZE = 4;      // "A X\n"
+const size_t CRLF_RECORD_SIZE = 5; // "A X\r\n"
+
+/// @brief A score for each kind of round, indexed by `[action][response]`.
+template <size_t N>
+using ScoreTableOf = std::array<std::array<unsigned int, N>, N>;
+
+/// @brief How many times each kind of round is played, indexed by `action * N + response`.
+template <size_t N>
+using RoundHistogramOf = std::array<unsigned long long, N * N>;
+
+/// @brief The rounds of a strategy guide, and the lines that were not rounds.
+template <size_t N>
+struct RoundCountsOf
+{
+  RoundHistogramOf<N> histogram{};
+  unsigned long long num_malformed = 0; // Lines that are not of the form "A X", including blank lines.
+};
+
+using ScoreTable = ScoreTableOf<NUM_SHAPES>;
+using RoundHistogram = RoundHistogramOf<NUM_SHAPES>;
+using RoundCounts = RoundCountsOf<NUM_SHAPES>;
+
+/// @brief Scores for both parts of day 2.
+struct StrategyScores
+{
+  unsigned long long score_by_shape = 0;  // Part 1: X, Y and Z are the shapes to play.
+  unsigned long long score_by_result = 0; // Part 2: X, Y and Z are the results to bring about.
+};
+
+/// @return The letter of the first response, so that the last one is 'Z'.
+template <size_t N>
+constexpr char get_first_response()
+{
+  static_assert(N % 2 == 1 && N <= 26, "A cyclic game needs an odd number of shapes, with one letter each.");
+  return (char)('Z' - (N - 1));
+}
+
+/// @brief Plays a round. Shapes are numbered from 0; for 3 shapes, 0 is rock, 1 is paper and 2 is scissors.
+/// @param action The opponent's shape.
+/// @param response Our shape.
+/// @return 0 for a loss, 1 for a draw, 2 for a win.
+template <size_t N = NUM_SHAPES>
+constexpr int play_round(int action, int response)
+{
+  int difference = ((response - action) % (int)N + (int)N) % (int)N;
+  return difference == 0 ? 1 : (difference % 2 == 1 ? 2 : 0);
+}
+
+/// @brief Scores a round where the response is a shape.
+/// @param action The opponent's shape.
+/// @param response Our shape.
+/// @return The score for the round.
+template <size_t N = NUM_SHAPES>
+constexpr unsigned int score_round_by_shape(int action, int response)
+{
+  return (response + 1) + play_round<N>(action, response) * 3;
+}
+
+/// @brief Scores a round where the response is the desired result. With more than 3 shapes, several shapes bring about the same
+/// result; the first of them is played.
+/// @param action The opponent's shape.
+/// @param result 0 to lose, 1 to draw, 2 to win.
+/// @return The score for the round.
+template <size_t N = NUM_SHAPES>
+constexpr unsigned int score_round_by_result(int action, int result)
+{
+  for (int response = 0; response < (int)N; response++)
+  {
+    if (play_round<N>(action, response) == result)
+    {
+      return score_round_by_shape<N>(action, response);
+    }
+  }
+  return 0;
+}
+
+/// @brief Tabulates a scoring function over every kind of round.
+/// @param score_round Called as `score_round(action, response)`.
+/// @return The table.
+template <size_t N = NUM_SHAPES, class ScoreRound>
+constexpr ScoreTableOf<N> make_score_table(ScoreRound score_round)
+{
+  ScoreTableOf<N> table{};
+  for (size_t action = 0; action < N; action++)
+  {
+    for (size_t response = 0; response < N; response++)
+    {
+      table[action][response] = score_round((int)action, (int)response);
+    }
+  }
+  return table;
+}
+
+/// @brief Results are only defined for the last 3 of the N responses: X, Y and Z are lose, draw and win for every N, as in the
+/// puzzle. The columns of the other responses are 0.
+template <size_t N>
+constexpr ScoreTableOf<N> make_result_score_table()
+{
+  return make_score_table<N>([](int action, int response)
+                             {
+                               int result = response - (int)(N - NUM_RESULTS);
+                               return result >= 0 ? score_round_by_result<N>(action, result) : 0; });
+}
+
+template <size_t N>
+constexpr ScoreTableOf<N> SCORES_BY_SHAPE_OF = make_score_table<N>(score_round_by_shape<N>);
+template <size_t N>
+constexpr ScoreTableOf<N> SCORES_BY_RESULT_OF = make_result_score_table<N>();
+
+constexpr ScoreTable SCORES_BY_SHAPE = SCORES_BY_SHAPE_OF<NUM_SHAPES>;
+constexpr ScoreTable SCORES_BY_RESULT = SCORES_BY_RESULT_OF<NUM_SHAPES>;
+
+/// @brief Takes the next round from the strategy guide.
+/// @param input The remaining strategy guide. The round's line is removed from the front.
+/// @param action Set to the opponent's shape, from 0 to N - 1.
+/// @param response Set to the response, from 0 to N - 1.
+/// @return Whether the line was a valid round. Other lines (e.g. a trailing blank line) should be skipped.
+template <size_t N = NUM_SHAPES>
+constexpr bool next_round(std::string_view &input, unsigned int &action, unsigned int &response)
+{
+  std::string_view line = utils::next_line(input);
+  if (line.size() < 3)
+  {
+    return false;
+  }
+  action = (unsigned int)(line[0] - 'A');
+  response = (unsigned int)(line[2] - get_first_response<N>());
+  return action < N && response < N;
+}
+
+/// @brief Takes the next round from the strategy guide and counts it.
+/// @param input The remaining strategy guide. The round's line is removed from the front.
+/// @param histogram The counts to add to.
+/// @return Whether the line was a valid round.
+template <size_t N = NUM_SHAPES>
+constexpr bool count_next_round(std::string_view &input, RoundHistogramOf<N> &histogram)
+{
+  unsigned int action = 0;
+  unsigned int response = 0;
+  if (!next_round<N>(input, action, response))
+  {
+    return false;
+  }
+  histogram[action * N + response]++;
+  return true;
+}
+
+/// @brief Counts each kind of round in the strategy guide. Usable in constant expressions.
+/// @param input The strategy guide: lines of the form "A X".
+/// @param histogram The counts to add to.
+/// @return The number of lines that were not rounds.
+template <size_t N = NUM_SHAPES>
+constexpr size_t count_round_types(std::string_view input, RoundHistogramOf<N> &histogram)
+{
+  size_t num_malformed = 0;
+  while (!input.empty())
+  {
+    num_malformed += !count_next_round<N>(input, histogram);
+  }
+  return num_malformed;
+}
+
+/// @brief Counts each kind of round in a strategy guide with CRLF line endings, whose records are `CRLF_RECORD_SIZE` bytes and so
+/// do not fit the SIMD lanes. Records are read at that fixed stride, into four interleaved histograms so that consecutive rounds
+/// of the same kind do not wait on each other's increments. Lines that break the stride are taken one at a time.
+/// @param input The strategy guide: lines of the form "A X\r\n".
+/// @param histogram The counts to add to.
+/// @return The number of lines that were not rounds.
+template <size_t N = NUM_SHAPES>
+size_t count_crlf_round_types(std::string_view input, RoundHistogramOf<N> &histogram)
+{
+  size_t num_malformed = 0;
+  RoundHistogramOf<N> partial_histograms[4] = {};
+  size_t i = 0;
+  for (size_t n = 0; i + CRLF_RECORD_SIZE <= input.size(); n++)
+  {
+    unsigned int action = (unsigned char)input[i] - 'A';
+    unsigned int response = (unsigned char)input[i + 2] - get_first_response<N>();
+    if (action < N && response < N && input[i + 1] == ' ' && input[i + 3] == '\r' && input[i + 4] == '\n')
+    {
+      partial_histograms[n & 3][action * N + response]++;
+      i += CRLF_RECORD_SIZE;
+      continue;
+    }
+    std::string_view rest = input.substr(i);
+    num_malformed += !count_next_round<N>(rest, histogram);
+    i = input.size() - rest.size();
+  }
+  num_malformed += count_round_types<N>(input.substr(i), histogram);
+
+  for (const RoundHistogramOf<N> &partial_histogram : partial_histograms)
+  {
+    for (size_t type = 0; type < N * N; type++)
+    {
+      histogram[type] += partial_histogram[type];
+    }
+  }
+  return num_malformed;
+}
+
+/// @brief Counts each kind of round in the strategy guide, classifying 8 (AVX2) or 4 (SSE2) records at a time.
+/// Every record is assumed to be exactly `RECORD_SIZE` bytes. When a block holds a record that is not, one line is taken the slow
+/// way and the kernel carries on from the line after it. Inputs with CRLF line endings go to `count_crlf_round_types` instead.
+/// @param input The strategy guide: lines of the form "A X".
+/// @param histogram The counts to add to.
+/// @return The number of lines that were not rounds.
+template <size_t N = NUM_SHAPES>
+size_t count_round_types_simd(std::string_view input, RoundHistogramOf<N> &histogram)
+{
+  if (input.size() >= CRLF_RECORD_SIZE && input[RECORD_SIZE - 1] == '\r')
+  {
+    return count_crlf_round_types<N>(input, histogram);
+  }
+
+  size_t num_malformed = 0;
+  size_t i = 0;
+
+  // Takes one line the slow way, for records that break the stride.
+  auto count_slow_line = [&]()
+  {
+    std::string_view rest = input.substr(i);
+    num_malformed += !count_next_round<N>(rest, histogram);
+    i = input.size() - rest.size();
+  };
+
+#if defined(__AVX2__) || defined(__SSE2__)
+  // Each 32-bit lane holds one record and counts one kind of round. The lane counters are flushed before they can overflow.
+  const size_t FLUSH_INTERVAL = (size_t)1 << 30;
+  RoundVector counts[N * N] = {};
+  size_t num_blocks = 0;
+  auto flush = [&]()
+  {
+    for (size_t type = 0; type < N * N; type++)
+    {
+      uint32_t lanes[sizeof(RoundVector) / sizeof(uint32_t)];
+      std::memcpy(lanes, &counts[type], sizeof(lanes));
+      for (uint32_t lane : lanes)
+      {
+        histogram[type] += lane;
+      }
+      counts[type] = RoundVector{};
+    }
+    num_blocks = 0;
+  };
+
+  while (i + sizeof(RoundVector) <= input.size())
+  {
+#if defined(__AVX2__)
+    __m256i records = _mm256_loadu_si256((const __m256i *)(input.data() + i));
+    __m256i action = _mm256_sub_epi32(_mm256_and_si256(records, _mm256_set1_epi32(0xFF)), _mm256_set1_epi32('A'));
+    __m256i response = _mm256_sub_epi32(_mm256_and_si256(_mm256_srli_epi32(records, 16), _mm256_set1_epi32(0xFF)),
+                                        _mm256_set1_epi32(get_first_response<N>()));
+    // A record is "<action> <response>\n" with both letters in range. The subtractions above cannot go below -'Z', so a signed
+    // compare against -1 and N is enough.
+    __m256i is_valid = _mm256_and_si256(
+        _mm256_cmpeq_epi32(_mm256_and_si256(records, _mm256_set1_epi32((int)0xFF00FF00)), _mm256_set1_epi32(0x0A002000)),
+        _mm256_and_si256(_mm256_and_si256(_mm256_cmpgt_epi32(action, _mm256_set1_epi32(-1)), _mm256_cmpgt_epi32(_mm256_set1_epi32((int)N), action)),
+                         _mm256_and_si256(_mm256_cmpgt_epi32(response, _mm256_set1_epi32(-1)), _mm256_cmpgt_epi32(_mm256_set1_epi32((int)N), response))));
+    if ((uint32_t)_mm256_movemask_epi8(is_valid) != 0xFFFFFFFF)
+    {
+      count_slow_line();
+      continue;
+    }
+    __m256i type = response;
+    for (size_t k = 0; k < N; k++)
+    {
+      type = _mm256_add_epi32(type, action);
+    }
+    for (size_t t = 0; t < N * N; t++)
+    {
+      counts[t] = _mm256_sub_epi32(counts[t], _mm256_cmpeq_epi32(type, _mm256_set1_epi32((int)t)));
+    }
+#else
+    __m128i records = _mm_loadu_si128((const __m128i *)(input.data() + i));
+    __m128i action = _mm_sub_epi32(_mm_and_si128(records, _mm_set1_epi32(0xFF)), _mm_set1_epi32('A'));
+    __m128i response = _mm_sub_epi32(_mm_and_si128(_mm_srli_epi32(records, 16), _mm_set1_epi32(0xFF)), _mm_set1_epi32(get_first_response<N>()));
+    __m128i is_valid = _mm_and_si128(
+        _mm_cmpeq_epi32(_mm_and_si128(records, _mm_set1_epi32((int)0xFF00FF00)), _mm_set1_epi32(0x0A002000)),
+        _mm_and_si128(_mm_and_si128(_mm_cmpgt_epi32(action, _mm_set1_epi32(-1)), _mm_cmplt_epi32(action, _mm_set1_epi32((int)N))),
+                      _mm_and_si128(_mm_cmpgt_epi32(response, _mm_set1_epi32(-1)), _mm_cmplt_epi32(response, _mm_set1_epi32((int)N)))));
+    if ((uint32_t)_mm_movemask_epi8(is_valid) != 0xFFFF)
+    {
+      count_slow_line();
+      continue;
+    }
+    __m128i type = response;
+    for (size_t k = 0; k < N; k++)
+    {
+      type = _mm_add_epi32(type, action);
+    }
+    for (size_t t = 0; t < N * N; t++)
+    {
+      counts[t] = _mm_sub_epi32(counts[t], _mm_cmpeq_epi32(type, _mm_set1_epi32((int)t)));
+    }
+#endif
+    i += sizeof(RoundVector);
+    if (++num_blocks == FLUSH_INTERVAL)
+    {
+      flush();
+    }
+  }
+  flush();
+#endif
+
+  while (i < input.size())
+  {
+    count_slow_line();
+  }
+  return num_malformed;
+}
+
+/// @brief Counts each kind of round, with each thread classifying its own chunk of the input into its own histogram.
+/// The chunks start at line breaks, so every chunk starts on a record boundary.
+/// @param input The strategy guide, e.g. the view of a `utils::MappedFile`.
+/// @param num_threads The most threads to use.
+/// @return The counts over the whole input.
+template <size_t N = NUM_SHAPES>
+RoundCountsOf<N> count_round_types_parallel(std::string_view input, size_t num_threads = utils::get_thread_count())
+{
+  size_t num_chunks = utils::get_chunk_count(input.size(), num_threads);
+  std::vector<std::string_view> chunks = utils::split_into_line_chunks(input, num_chunks);
+  std::vector<RoundCountsOf<N>> chunk_counts(chunks.size());
+
+  utils::parallel_for(
+      chunks.size(), [&](size_t begin, size_t end, size_t)
+      {
+        for (size_t i = begin; i < end; i++)
+        {
+          chunk_counts[i].num_malformed = count_round_types_simd<N>(chunks[i], chunk_counts[i].histogram);
+        } },
+      chunks.size());
+
+  RoundCountsOf<N> counts;
+  for (const RoundCountsOf<N> &chunk : chunk_counts)
+  {
+    for (size_t type = 0; type < N * N; type++)
+    {
+      counts.histogram[type] += chunk.histogram[type];
+    }
+    counts.num_malformed += chunk.num_malformed;
+  }
+  return counts;
+}
+
+/// @brief Totals the scores of a histogram of rounds.
+/// @param histogram The counts of each kind of round.
+/// @param table The score of each kind of round.
+/// @return The total score.
+template <size_t N>
+constexpr unsigned long long score_histogram(const RoundHistogramOf<N> &histogram, const ScoreTableOf<N> &table)
+{
+  unsigned long long score = 0;
+  for (size_t action = 0; action < N; action++)
+  {
+    for (size_t response = 0; response < N; response++)
+    {
+      score += histogram[action * N + response] * table[action][response];
+    }
+  }
+  return score;
+}
+
+/// @brief Follows the strategy guide under both interpretations, without allocating. Usable in constant expressions.
+/// @param input The strategy guide: lines of the form "A X".
+/// @return The total scores.
+constexpr StrategyScores score_strategy_guide(std::string_view input)
+{
+  RoundHistogram histogram{};
+  count_round_types(input, histogram);
+  return StrategyScores{score_histogram(histogram, SCORES_BY_SHAPE), score_histogram(histogram, SCORES_BY_RESULT)};
+}
+
+const size_t NUM_MAPPINGS = 2 * 6; // Every permutation of X, Y and Z, read once as shapes and once as results.
+
+/// @brief One way of reading X, Y and Z.
+struct StrategyMapping
+{
+  bool is_by_result = false;              // Whether X, Y and Z are results to bring about rather than shapes to play.
+  std::array<int, NUM_SHAPES> meanings{}; // What X, Y and Z stand for: shapes (0 is rock) or results (0 is a loss).
+  ScoreTable table{};                     // The score of each kind of round under this reading.
+};
+
+/// @brief Tabulates the scores of every reading of X, Y and Z.
+/// @return The readings: first the shape permutations, then the result permutations, each in lexicographic order.
+constexpr std::array<StrategyMapping, NUM_MAPPINGS> make_strategy_mappings()
+{
+  std::array<StrategyMapping, NUM_MAPPINGS> mappings{};
+  size_t n = 0;
+  for (bool is_by_result : {false, true})
+  {
+    std::array<int, NUM_SHAPES> meanings = {0, 1, 2};
+    do
+    {
+      StrategyMapping &mapping = mappings[n++];
+      mapping.is_by_result = is_by_result;
+      mapping.meanings = meanings;
+      mapping.table = make_score_table([&](int action, int response)
+                                       { return is_by_result ? score_round_by_result(action, meanings[response])
+                                                             : score_round_by_shape(action, meanings[response]); });
+    } while (std::next_permutation(meanings.begin(), meanings.end()));
+  }
+  return mappings;
+}
+
+constexpr std::array<StrategyMapping, NUM_MAPPINGS> STRATEGY_MAPPINGS = make_strategy_mappings();
+static_assert(STRATEGY_MAPPINGS[0].table == SCORES_BY_SHAPE && STRATEGY_MAPPINGS[NUM_MAPPINGS / 2].table == SCORES_BY_RESULT,
+              "The identity readings should match the puzzle's two parts.");
+
+/// @brief Totals the strategy guide under every reading of X, Y and Z, from one histogram of its rounds.
+/// @param histogram The counts of each kind of round.
+/// @return The total score of each of `STRATEGY_MAPPINGS`.
+constexpr std::array<unsigned long long, NUM_MAPPINGS> score_all_mappings(const RoundHistogram &histogram)
+{
+  std::array<unsigned long long, NUM_MAPPINGS> scores{};
+  for (size_t i = 0; i < NUM_MAPPINGS; i++)
+  {
+    scores[i] = score_histogram(histogram, STRATEGY_MAPPINGS[i].table);
+  }
+  return scores;
+}
@@ -0,0 +1,28 @@
+//-------------------------------------------------------------------------------------------------
+// Day 02: Rock Paper Scissors (compile-time)
+// by Rene Jotham C. Culaway
+//
+// Solves an embedded input entirely at compile time. Generate `input.embedded.hpp` with
+// `embed_input input.txt input.embedded.hpp`, then build with `-DEXPECTED_PART_1=<answer>` and
+// `-DEXPECTED_PART_2=<answer>` to have the answers checked by `static_assert`.
+//-------------------------------------------------------------------------------------------------
+
+#include <iostream>
+#include "day02.hpp"
+#include "input.embedded.hpp"
+
+constexpr StrategyScores SCORES = score_strategy_guide(EMBEDDED_INPUT);
+
+#ifdef EXPECTED_PART_1
+static_assert(SCORES.score_by_shape == EXPECTED_PART_1, "Part 1 does not match the expected answer.");
+#endif
+#ifdef EXPECTED_PART_2
+static_assert(SCORES.score_by_result == EXPECTED_PART_2, "Part 2 does not match the expected answer.");
+#endif
+
+int main(int argc, char *argv[])
+{
+  std::cout << "Total score if X, Y and Z are shapes:\t" << SCORES.score_by_shape << "\n";
+  std::cout << "Total score if X, Y and Z are results:\t" << SCORES.score_by_result << "\n";
+  return 0;
+}
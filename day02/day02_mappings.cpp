@@ -0,0 +1,61 @@
+//-------------------------------------------------------------------------------------------------
+// Day 02: Rock Paper Scissors (every reading of X, Y and Z)
+// by Rene Jotham C. Culaway
+//
+// Reads the strategy guide once, then totals it under every permutation of X, Y and Z as shapes
+// and as results, and reports the best and worst readings.
+//-------------------------------------------------------------------------------------------------
+
+#include <iostream>
+#include <string>
+#include <stdexcept>
+#include "day02.hpp"
+#include "../utils/mapped_file.hpp"
+
+const std::string FILE_NAME = "day02_input.txt";
+const char *SHAPE_NAMES[NUM_SHAPES] = {"rock", "paper", "scissors"};
+const char *RESULT_NAMES[NUM_SHAPES] = {"lose", "draw", "win"};
+
+/// @brief Describes a reading of X, Y and Z, e.g. "X=rock Y=paper Z=scissors".
+/// @param mapping The reading.
+/// @return The description.
+std::string describe_mapping(const StrategyMapping &mapping)
+{
+  std::string description;
+  for (size_t response = 0; response < NUM_SHAPES; response++)
+  {
+    const char *const *names = mapping.is_by_result ? RESULT_NAMES : SHAPE_NAMES;
+    description += (response > 0 ? " " : "") + std::string(1, (char)('X' + response)) + "=" + names[mapping.meanings[response]];
+  }
+  return description;
+}
+
+int main(int argc, char *argv[])
+{
+  std::string file_name = argc > 1 ? argv[1] : FILE_NAME;
+  size_t num_threads = argc > 2 ? std::stoull(argv[2]) : utils::get_thread_count();
+
+  try
+  {
+    utils::MappedFile input_file(file_name);
+    RoundCounts counts = count_round_types_parallel(input_file.view(), num_threads);
+    std::array<unsigned long long, NUM_MAPPINGS> scores = score_all_mappings(counts.histogram);
+
+    size_t best = 0;
+    size_t worst = 0;
+    for (size_t i = 0; i < NUM_MAPPINGS; i++)
+    {
+      std::cout << describe_mapping(STRATEGY_MAPPINGS[i]) << ":\t" << scores[i] << "\n";
+      best = scores[i] > scores[best] ? i : best;
+      worst = scores[i] < scores[worst] ? i : worst;
+    }
+    std::cout << "Best reading:\t" << describe_mapping(STRATEGY_MAPPINGS[best]) << " (" << scores[best] << ")\n";
+    std::cout << "Worst reading:\t" << describe_mapping(STRATEGY_MAPPINGS[worst]) << " (" << scores[worst] << ")\n";
+  }
+  catch (std::runtime_error &)
+  {
+    return 1;
+  }
+
+  return 0;
+}
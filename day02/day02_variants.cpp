@@ -0,0 +1,66 @@
+//-------------------------------------------------------------------------------------------------
+// Day 02: Rock Paper Scissors (variants with more shapes)
+// by Rene Jotham C. Culaway
+//
+// Scores a strategy guide for a cyclic game with 3, 5 or 7 shapes. Usage:
+// `day02_variants <shapes> [input] [threads]`. Actions are written from A and responses up to Z,
+// e.g. A to E against V to Z for 5 shapes. When the responses are read as results, X, Y and Z are
+// lose, draw and win for every variant, as in the puzzle, and the other responses score nothing.
+// Each variant is its own instantiation, with its score tables built at compile time.
+//-------------------------------------------------------------------------------------------------
+
+#include <iostream>
+#include <string>
+#include <stdexcept>
+#include "day02.hpp"
+#include "../utils/mapped_file.hpp"
+
+const std::string FILE_NAME = "day02_input.txt";
+
+/// @brief Scores a strategy guide for a game with `N` shapes and prints both totals.
+/// @param input The strategy guide.
+/// @param num_threads The most threads to use.
+template <size_t N>
+void score_variant(std::string_view input, size_t num_threads)
+{
+  RoundCountsOf<N> counts = count_round_types_parallel<N>(input, num_threads);
+  std::cout << "Total score if the responses are shapes:\t" << score_histogram(counts.histogram, SCORES_BY_SHAPE_OF<N>) << "\n";
+  std::cout << "Total score if the responses are results:\t" << score_histogram(counts.histogram, SCORES_BY_RESULT_OF<N>) << "\n";
+  if (counts.num_malformed > 0)
+  {
+    std::cout << "Lines skipped:\t" << counts.num_malformed << "\n";
+  }
+}
+
+int main(int argc, char *argv[])
+{
+  size_t num_shapes = argc > 1 ? std::stoull(argv[1]) : NUM_SHAPES;
+  std::string file_name = argc > 2 ? argv[2] : FILE_NAME;
+  size_t num_threads = argc > 3 ? std::stoull(argv[3]) : utils::get_thread_count();
+
+  try
+  {
+    utils::MappedFile input_file(file_name);
+    switch (num_shapes)
+    {
+    case 3:
+      score_variant<3>(input_file.view(), num_threads);
+      break;
+    case 5:
+      score_variant<5>(input_file.view(), num_threads);
+      break;
+    case 7:
+      score_variant<7>(input_file.view(), num_threads);
+      break;
+    default:
+      std::cout << "Only 3, 5 and 7 shapes are built in.\n";
+      return 1;
+    }
+  }
+  catch (std::runtime_error &)
+  {
+    return 1;
+  }
+
+  return 0;
+}
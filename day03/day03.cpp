@@ -0,0 +1,38 @@
+//-------------------------------------------------------------------------------------------------
+// Day 03: Rucksack Reorganization
+// by Rene Jotham C. Culaway
+//
+// Part 1: Find the item type that appears in both compartments of each rucksack.
+// Part 2: Find the item type that corresponds to the badges of each group of Elves.
+// What are the sums of the priorities of those item types? Both are found in one read of the input.
+// Usage: `day03 [input] [elves per group] [threads]`.
+//-------------------------------------------------------------------------------------------------
+#include <iostream>
+#include <string>
+#include <stdexcept>
+#include "day03.hpp"
+#include "../utils/mapped_file.hpp"
+
+const std::string FILE_NAME = "input.txt";
+
+int main(int argc, char *argv[])
+{
+  std::string file_name = argc > 1 ? argv[1] : FILE_NAME;
+  size_t elves_per_group = argc > 2 ? std::max<size_t>(1, std::stoull(argv[2])) : ELVES_PER_GROUP;
+  size_t num_threads = argc > 3 ? std::stoull(argv[3]) : utils::get_thread_count();
+
+  try
+  {
+    utils::MappedFile file_handle(file_name);
+    PrioritySums sums = sum_priorities_parallel(file_handle.view(), elves_per_group, num_threads);
+
+    std::cout << "Compartment priority sum:\t" << sums.compartment_priority_sum << "\n";
+    std::cout << "Badge priority sum:\t" << sums.badge_priority_sum << "\n";
+  }
+  catch (std::runtime_error &)
+  {
+    return 1;
+  }
+
+  return 0;
+}
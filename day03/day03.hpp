@@ -0,0 +1,429 @@
+#pragma once
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <cstdint>
+#include <cstring>
+#include <string_view>
+#include <utility>
+#include <vector>
+#include "../utils/text.hpp"
+#include "../utils/simd.hpp"
+#include "../utils/parallel.hpp"
+
+#if defined(__AVX2__)
+using ItemVector = __m256i;
+#elif defined(__SSSE3__)
+using ItemVector = __m128i;
+#endif
+
+const size_t NUM_ITEM_TYPES = 52;
+const size_t ELVES_PER_GROUP = 3; // The default size of a badge group.
+const size_t NUM_ITEM_BYTES = (NUM_ITEM_TYPES + 7) / 8; // The bytes of an item mask that can hold item types.
+
+/// @brief A set of item types, with bit `priority - 1` standing for the item type of that priority.
+using ItemMask = uint64_t;
+
+/// @brief How often each item type turns up, indexed by `priority - 1`.
+struct ItemFrequencies
+{
+  std::array<unsigned long long, NUM_ITEM_TYPES> rucksacks{}; // The number of rucksacks holding the item type.
+  std::array<unsigned long long, NUM_ITEM_TYPES> groups{};    // The number of groups in which every elf carries it.
+  std::array<unsigned long long, NUM_ITEM_TYPES> badges{};    // The number of groups whose badge it is.
+
+  /// @brief Adds the counts of another part of the input, e.g. one scanned by another thread.
+  constexpr void merge(const ItemFrequencies &other)
+  {
+    for (size_t i = 0; i < NUM_ITEM_TYPES; i++)
+    {
+      rucksacks[i] += other.rucksacks[i];
+      groups[i] += other.groups[i];
+      badges[i] += other.badges[i];
+    }
+  }
+
+  /// @return The priority of the item type that is most often a badge (the lowest on ties), or 0 if there were no groups.
+  constexpr int get_most_common_badge() const
+  {
+    size_t most_common = std::max_element(badges.begin(), badges.end()) - badges.begin();
+    return badges[most_common] > 0 ? (int)most_common + 1 : 0;
+  }
+
+  constexpr bool operator==(const ItemFrequencies &other) const = default;
+};
+
+/// @brief Sums of priorities for both parts of day 3.
+struct PrioritySums
+{
+  unsigned int compartment_priority_sum = 0; // Part 1: items found in both compartments of a rucksack.
+  unsigned int badge_priority_sum = 0;       // Part 2: items carried by every elf in a group.
+  ItemFrequencies item_frequencies;          // Gathered in the same pass.
+
+  constexpr bool operator==(const PrioritySums &other) const = default;
+};
+
+/// @brief Converts a character in ASCII to its equivalent priority. 1-26 is the priority for a to z, while 27-52 is the priority for A-Z.
+/// @param c The character to convert
+/// @return The priority value of the character.
+constexpr int item_type_to_priority(char c)
+{
+  return c >= 'a' ? c - 'a' + 1 : c - 'A' + 27;
+}
+
+/// @brief Does the opposite of `item_type_to_priority`.
+/// @param priority The priority, from 1 to 52.
+/// @return The item type.
+constexpr char priority_to_item_type(int priority)
+{
+  return priority <= 26 ? (char)('a' + priority - 1) : (char)('A' + priority - 27);
+}
+
+/// @brief Maps every byte to the mask of its item type, or to 0 if it is not a letter.
+constexpr std::array<ItemMask, 256> make_item_masks()
+{
+  std::array<ItemMask, 256> masks{};
+  for (int c = 0; c < 256; c++)
+  {
+    if ((c >= 'a' && c <= 'z') || (c >= 'A' && c <= 'Z'))
+    {
+      masks[c] = (ItemMask)1 << (item_type_to_priority((char)c) - 1);
+    }
+  }
+  return masks;
+}
+
+constexpr std::array<ItemMask, 256> ITEM_MASKS = make_item_masks();
+
+/// @brief Collects the item types in a list of items.
+/// @param items The items, one letter each.
+/// @return The set of item types.
+constexpr ItemMask make_item_mask(std::string_view items)
+{
+  ItemMask mask = 0;
+  for (char c : items)
+  {
+    mask |= ITEM_MASKS[(unsigned char)c];
+  }
+  return mask;
+}
+
+/// @brief Gets the priority of the item type in a set. If there are several, the lowest priority is taken.
+/// @param mask The set of item types.
+/// @return The priority, or 0 if the set is empty.
+constexpr int mask_to_priority(ItemMask mask)
+{
+  return mask == 0 ? 0 : std::countr_zero(mask) + 1;
+}
+
+/// @brief Finds the item type in both compartments of a rucksack.
+/// @param rucksack The rucksack's items. The first half is the first compartment.
+/// @return The priority of the shared item type.
+constexpr int get_compartment_priority(std::string_view rucksack)
+{
+  size_t half = rucksack.size() / 2;
+  return mask_to_priority(make_item_mask(rucksack.substr(0, half)) & make_item_mask(rucksack.substr(half)));
+}
+
+/// @brief Counts how many of a stream of item masks hold each item type, with all 64 bits counted at once. The counts are kept
+/// bit-sliced: bit `i` of `count_bits[k]` is bit `k` of the count for item type `i`, so adding a mask is a ripple-carry add of
+/// whole words instead of a loop over its item types. The counts are moved into ordinary bins before they can overflow.
+class ItemCounter
+{
+  static constexpr size_t NUM_COUNT_BITS = 8;
+  static constexpr size_t MAX_PENDING = ((size_t)1 << NUM_COUNT_BITS) - 1;
+
+  ItemMask count_bits[NUM_COUNT_BITS] = {};
+  size_t num_pending = 0;
+
+public:
+  /// @param mask The item types to count once more.
+  /// @param bins The bins to move the counts to when they are about to overflow.
+  constexpr void add(ItemMask mask, std::array<unsigned long long, NUM_ITEM_TYPES> &bins)
+  {
+    ItemMask carry = mask;
+    for (size_t k = 0; k < NUM_COUNT_BITS && carry != 0; k++)
+    {
+      ItemMask next_carry = count_bits[k] & carry;
+      count_bits[k] ^= carry;
+      carry = next_carry;
+    }
+    if (++num_pending == MAX_PENDING)
+    {
+      flush(bins);
+    }
+  }
+
+  /// @brief Moves the counts so far to the bins.
+  /// @param bins The bins, indexed by `priority - 1`.
+  constexpr void flush(std::array<unsigned long long, NUM_ITEM_TYPES> &bins)
+  {
+    for (size_t i = 0; i < NUM_ITEM_TYPES; i++)
+    {
+      unsigned long long count = 0;
+      for (size_t k = 0; k < NUM_COUNT_BITS; k++)
+      {
+        count |= ((count_bits[k] >> i) & 1) << k;
+      }
+      bins[i] += count;
+    }
+    std::fill(count_bits, count_bits + NUM_COUNT_BITS, 0);
+    num_pending = 0;
+  }
+};
+
+/// @brief Keeps the running sums while rucksacks are read in order.
+struct PriorityScanner
+{
+  size_t elves_per_group;
+  PrioritySums sums;
+  ItemMask group_mask = ~(ItemMask)0; // The item types carried by every elf in the group so far.
+  size_t elf_idx = 0;
+  ItemCounter rucksack_counter;
+  ItemCounter group_counter;
+
+  constexpr PriorityScanner(size_t elves_per_group = ELVES_PER_GROUP) : elves_per_group(elves_per_group) {}
+
+  /// @brief Adds the next rucksack. The compartment answer comes from its two halves, and their union goes towards the badge.
+  /// @param first_half The item types in the first compartment.
+  /// @param second_half The item types in the second compartment.
+  constexpr void add_rucksack(ItemMask first_half, ItemMask second_half)
+  {
+    sums.compartment_priority_sum += mask_to_priority(first_half & second_half);
+    group_mask &= first_half | second_half;
+    rucksack_counter.add(first_half | second_half, sums.item_frequencies.rucksacks);
+
+    if (++elf_idx == elves_per_group)
+    {
+      int badge_priority = mask_to_priority(group_mask);
+      sums.badge_priority_sum += badge_priority;
+      if (badge_priority > 0)
+      {
+        sums.item_frequencies.badges[badge_priority - 1]++;
+      }
+      group_counter.add(group_mask, sums.item_frequencies.groups);
+      group_mask = ~(ItemMask)0;
+      elf_idx = 0;
+    }
+  }
+
+  /// @return The sums and item frequencies of every rucksack added.
+  constexpr PrioritySums finish()
+  {
+    rucksack_counter.flush(sums.item_frequencies.rucksacks);
+    group_counter.flush(sums.item_frequencies.groups);
+    return sums;
+  }
+};
+
+/// @brief Finds both priority sums and the item frequencies in a single pass, without allocating. Each line is read once: the masks of its two halves give
+/// the compartment answer, and their union goes towards the group's badge. Usable in constant expressions.
+/// @param input The list of rucksacks, one per line.
+/// @param elves_per_group The number of elves in each badge group.
+/// @return The priority sums.
+constexpr PrioritySums sum_priorities(std::string_view input, size_t elves_per_group = ELVES_PER_GROUP)
+{
+  PriorityScanner scanner(elves_per_group);
+
+  while (!input.empty())
+  {
+    std::string_view line = utils::next_line(input);
+    if (line.empty())
+    {
+      continue;
+    }
+
+    size_t half = line.size() / 2;
+    scanner.add_rucksack(make_item_mask(line.substr(0, half)), make_item_mask(line.substr(half)));
+  }
+
+  return scanner.finish();
+}
+
+#if defined(__AVX2__) || defined(__SSSE3__)
+/// @brief Adds the item types in one vector of bytes to the bins of an item mask. Each letter becomes its bit index `i`, which is
+/// split into the byte `i / 8` of the mask, and the bit `i % 8` within it, which a shuffle looks up. Byte `g` of the mask is then
+/// the OR of the bits of the letters in byte `g`, which each bin gathers lane by lane. Bytes that are not letters add nothing.
+/// @param block The bytes. All `sizeof(ItemVector)` bytes must be readable.
+/// @param bins The bins, one per byte of the mask.
+inline void add_item_block(const char *block, ItemVector (&bins)[NUM_ITEM_BYTES])
+{
+#if defined(__AVX2__)
+  __m256i items = _mm256_loadu_si256((const __m256i *)block);
+  // Unsigned range checks: x <= 25 exactly when min(x, 25) == x.
+  __m256i lower = _mm256_sub_epi8(items, _mm256_set1_epi8('a'));
+  __m256i upper = _mm256_sub_epi8(items, _mm256_set1_epi8('A'));
+  __m256i is_lower = _mm256_cmpeq_epi8(_mm256_min_epu8(lower, _mm256_set1_epi8(25)), lower);
+  __m256i is_upper = _mm256_cmpeq_epi8(_mm256_min_epu8(upper, _mm256_set1_epi8(25)), upper);
+  __m256i index = _mm256_blendv_epi8(_mm256_add_epi8(upper, _mm256_set1_epi8(26)), lower, is_lower);
+
+  __m256i bit = _mm256_shuffle_epi8(_mm256_setr_epi8(1, 2, 4, 8, 16, 32, 64, -128, 1, 2, 4, 8, 16, 32, 64, -128,
+                                                     1, 2, 4, 8, 16, 32, 64, -128, 1, 2, 4, 8, 16, 32, 64, -128),
+                                    _mm256_and_si256(index, _mm256_set1_epi8(7)));
+  bit = _mm256_and_si256(bit, _mm256_or_si256(is_lower, is_upper));
+  // There is no byte shift, so the bits shifted in from the neighbouring byte are masked off.
+  __m256i byte = _mm256_and_si256(_mm256_srli_epi16(index, 3), _mm256_set1_epi8(7));
+  // Spelled out for every bin, so that the bins stay in registers instead of going through memory on each block.
+  [&]<size_t... G>(std::index_sequence<G...>)
+  { ((bins[G] = _mm256_or_si256(bins[G], _mm256_and_si256(bit, _mm256_cmpeq_epi8(byte, _mm256_set1_epi8((char)G))))), ...); }(std::make_index_sequence<NUM_ITEM_BYTES>{});
+#else
+  __m128i items = _mm_loadu_si128((const __m128i *)block);
+  __m128i lower = _mm_sub_epi8(items, _mm_set1_epi8('a'));
+  __m128i upper = _mm_sub_epi8(items, _mm_set1_epi8('A'));
+  __m128i is_lower = _mm_cmpeq_epi8(_mm_min_epu8(lower, _mm_set1_epi8(25)), lower);
+  __m128i is_upper = _mm_cmpeq_epi8(_mm_min_epu8(upper, _mm_set1_epi8(25)), upper);
+  __m128i index = _mm_or_si128(_mm_and_si128(is_lower, lower), _mm_andnot_si128(is_lower, _mm_add_epi8(upper, _mm_set1_epi8(26))));
+
+  __m128i bit = _mm_shuffle_epi8(_mm_setr_epi8(1, 2, 4, 8, 16, 32, 64, -128, 1, 2, 4, 8, 16, 32, 64, -128),
+                                 _mm_and_si128(index, _mm_set1_epi8(7)));
+  bit = _mm_and_si128(bit, _mm_or_si128(is_lower, is_upper));
+  __m128i byte = _mm_and_si128(_mm_srli_epi16(index, 3), _mm_set1_epi8(7));
+  [&]<size_t... G>(std::index_sequence<G...>)
+  { ((bins[G] = _mm_or_si128(bins[G], _mm_and_si128(bit, _mm_cmpeq_epi8(byte, _mm_set1_epi8((char)G))))), ...); }(std::make_index_sequence<NUM_ITEM_BYTES>{});
+#endif
+}
+#endif
+
+/// @brief Does the same as `make_item_mask`, but maps 32 (AVX2) or 16 (SSSE3) letters at a time with `add_item_block`.
+/// Lists shorter than a vector are looked up one letter at a time, which is faster than setting up the bins.
+/// @param items The items, one letter each.
+/// @return The set of item types.
+ItemMask make_item_mask_simd(std::string_view items)
+{
+#if defined(__AVX2__) || defined(__SSSE3__)
+  if (items.size() < sizeof(ItemVector))
+  {
+    return make_item_mask(items);
+  }
+
+  ItemVector bins[NUM_ITEM_BYTES] = {};
+  size_t i = 0;
+  for (; i + sizeof(ItemVector) <= items.size(); i += sizeof(ItemVector))
+  {
+    add_item_block(items.data() + i, bins);
+  }
+  if (i < items.size())
+  {
+    // The last vector is padded with zeroes, which are not letters, so that nothing past the end of the items is read.
+    char tail[sizeof(ItemVector)] = {};
+    std::memcpy(tail, items.data() + i, items.size() - i);
+    add_item_block(tail, bins);
+  }
+
+  ItemMask mask = 0;
+  for (size_t g = 0; g < NUM_ITEM_BYTES; g++)
+  {
+    uint64_t words[sizeof(ItemVector) / sizeof(uint64_t)];
+    std::memcpy(words, &bins[g], sizeof(words));
+    uint64_t bits = 0;
+    for (uint64_t word : words)
+    {
+      bits |= word;
+    }
+    bits |= bits >> 32;
+    bits |= bits >> 16;
+    bits |= bits >> 8;
+    mask |= (bits & 0xFF) << (8 * g);
+  }
+  return mask;
+#else
+  return make_item_mask(items);
+#endif
+}
+
+/// @brief Does the same as `sum_priorities`, but finds the line breaks with `utils::for_each_line` and builds each compartment's
+/// mask with `make_item_mask_simd`.
+/// @param input The list of rucksacks, one per line.
+/// @param elves_per_group The number of elves in each badge group.
+/// @return The priority sums.
+PrioritySums sum_priorities_simd(std::string_view input, size_t elves_per_group = ELVES_PER_GROUP)
+{
+  PriorityScanner scanner(elves_per_group);
+  utils::for_each_line(input, [&](std::string_view line)
+                       {
+                         if (!line.empty())
+                         {
+                           size_t half = line.size() / 2;
+                           scanner.add_rucksack(make_item_mask_simd(line.substr(0, half)), make_item_mask_simd(line.substr(half)));
+                         } });
+  return scanner.finish();
+}
+
+/// @brief Counts the rucksacks in a block of text. Blank lines are not rucksacks.
+/// @param text The text.
+/// @return The number of rucksacks.
+size_t count_rucksacks(std::string_view text)
+{
+  size_t num_rucksacks = 0;
+  utils::for_each_line(text, [&](std::string_view line)
+                       { num_rucksacks += !line.empty(); });
+  return num_rucksacks;
+}
+
+/// @brief Finds where a block of text continues after a number of rucksacks.
+/// @param text The text, starting at the beginning of a line.
+/// @param num_rucksacks The number of rucksacks to skip.
+/// @return The offset of the line after the last rucksack skipped, or the end of the text if it runs out first.
+size_t skip_rucksacks(std::string_view text, size_t num_rucksacks)
+{
+  std::string_view rest = text;
+  while (num_rucksacks > 0 && !rest.empty())
+  {
+    num_rucksacks -= !utils::next_line(rest).empty();
+  }
+  return text.size() - rest.size();
+}
+
+/// @brief Finds both priority sums, with each thread summing its own chunk of the input with `sum_priorities_simd`.
+/// A badge group must not be split between chunks, so the chunks are moved to start on a group boundary first: each thread
+/// counts the rucksacks in a line-aligned chunk, and the running totals give how many rucksacks each chunk must hand over to the
+/// one before it. The answers are the same as `sum_priorities` for any number of threads.
+/// @param input The list of rucksacks, e.g. the view of a `utils::MappedFile`.
+/// @param elves_per_group The number of elves in each badge group.
+/// @param num_threads The most threads to use.
+/// @return The priority sums.
+PrioritySums sum_priorities_parallel(std::string_view input, size_t elves_per_group = ELVES_PER_GROUP,
+                                     size_t num_threads = utils::get_thread_count())
+{
+  size_t num_chunks = utils::get_chunk_count(input.size(), num_threads);
+  std::vector<std::string_view> chunks = utils::split_into_line_chunks(input, num_chunks);
+  std::vector<size_t> num_rucksacks(chunks.size());
+
+  utils::parallel_for(
+      chunks.size(), [&](size_t begin, size_t end, size_t)
+      {
+        for (size_t i = begin; i < end; i++)
+        {
+          num_rucksacks[i] = count_rucksacks(chunks[i]);
+        } },
+      chunks.size());
+
+  // Each chunk's new start is the first group boundary at or after its old start, which only depends on the rucksacks before it.
+  std::vector<size_t> group_starts(chunks.size() + 1, input.size());
+  size_t rucksacks_before = 0;
+  for (size_t i = 0; i < chunks.size(); i++)
+  {
+    size_t chunk_start = chunks[i].data() - input.data();
+    size_t num_to_skip = (elves_per_group - rucksacks_before % elves_per_group) % elves_per_group;
+    group_starts[i] = chunk_start + skip_rucksacks(input.substr(chunk_start), num_to_skip);
+    rucksacks_before += num_rucksacks[i];
+  }
+
+  std::vector<PrioritySums> chunk_sums(chunks.size());
+  utils::parallel_for(
+      chunks.size(), [&](size_t begin, size_t end, size_t)
+      {
+        for (size_t i = begin; i < end; i++)
+        {
+          chunk_sums[i] = sum_priorities_simd(input.substr(group_starts[i], group_starts[i + 1] - group_starts[i]), elves_per_group);
+        } },
+      chunks.size());
+
+  PrioritySums sums;
+  for (const PrioritySums &chunk : chunk_sums)
+  {
+    sums.compartment_priority_sum += chunk.compartment_priority_sum;
+    sums.badge_priority_sum += chunk.badge_priority_sum;
+    sums.item_frequencies.merge(chunk.item_frequencies);
+  }
+  return sums;
+}
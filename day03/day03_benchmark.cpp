@@ -0,0 +1,55 @@
+//-------------------------------------------------------------------------------------------------
+// Day 03: Rucksack Reorganization (throughput benchmark)
+// by Rene Jotham C. Culaway
+//
+// Times the scalar table lookups against the SIMD mask builder on the same input, checks that
+// their sums and item frequencies agree, and reports each one's throughput in GB/s. Long rucksacks
+// show the difference best.
+//-------------------------------------------------------------------------------------------------
+
+#include <iostream>
+#include <string>
+#include <stdexcept>
+#include "day03.hpp"
+#include "../utils/mapped_file.hpp"
+#include "../utils/benchmark.hpp"
+
+const std::string FILE_NAME = "input.txt";
+const size_t DEFAULT_REPETITIONS = 5;
+
+int main(int argc, char *argv[])
+{
+  std::string file_name = argc > 1 ? argv[1] : FILE_NAME;
+  size_t repetitions = argc > 2 ? std::stoull(argv[2]) : DEFAULT_REPETITIONS;
+
+  try
+  {
+    utils::MappedFile input_file(file_name);
+    std::string_view input = input_file.view();
+
+    PrioritySums scalar = utils::report_throughput("scalar masks", input.size(), repetitions, [&]()
+                                                   { return sum_priorities(input); });
+    PrioritySums simd = utils::report_throughput("SIMD masks", input.size(), repetitions, [&]()
+                                                 { return sum_priorities_simd(input); });
+    PrioritySums parallel = utils::report_throughput("SIMD masks, all threads", input.size(), repetitions, [&]()
+                                                     { return sum_priorities_parallel(input); });
+
+    std::cout << "Compartment priority sum:\t" << scalar.compartment_priority_sum << "\n";
+    std::cout << "Badge priority sum:\t" << scalar.badge_priority_sum << "\n";
+
+    std::cout << "Most common badge:\t" << scalar.item_frequencies.get_most_common_badge() << "\n";
+
+    // Both sums and every item frequency count (per rucksack, per group and per badge) must agree.
+    if (simd != scalar || parallel != scalar)
+    {
+      std::cout << "MISMATCH\n";
+      return 1;
+    }
+  }
+  catch (std::runtime_error &)
+  {
+    return 1;
+  }
+
+  return 0;
+}
@@ -0,0 +1,28 @@
+//-------------------------------------------------------------------------------------------------
+// Day 03: Rucksack Reorganization (compile-time)
+// by Rene Jotham C. Culaway
+//
+// Solves an embedded input entirely at compile time. Generate `input.embedded.hpp` with
+// `embed_input input.txt input.embedded.hpp`, then build with `-DEXPECTED_PART_1=<answer>` and
+// `-DEXPECTED_PART_2=<answer>` to have the answers checked by `static_assert`.
+//-------------------------------------------------------------------------------------------------
+
+#include <iostream>
+#include "day03.hpp"
+#include "input.embedded.hpp"
+
+constexpr PrioritySums SUMS = sum_priorities(EMBEDDED_INPUT);
+
+#ifdef EXPECTED_PART_1
+static_assert(SUMS.compartment_priority_sum == EXPECTED_PART_1, "Part 1 does not match the expected answer.");
+#endif
+#ifdef EXPECTED_PART_2
+static_assert(SUMS.badge_priority_sum == EXPECTED_PART_2, "Part 2 does not match the expected answer.");
+#endif
+
+int main(int argc, char *argv[])
+{
+  std::cout << "Compartment priority sum:\t" << SUMS.compartment_priority_sum << "\n";
+  std::cout << "Badge priority sum:\t" << SUMS.badge_priority_sum << "\n";
+  return 0;
+}
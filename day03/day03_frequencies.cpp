@@ -0,0 +1,49 @@
+//-------------------------------------------------------------------------------------------------
+// Day 03: Rucksack Reorganization (item frequencies)
+// by Rene Jotham C. Culaway
+//
+// Reads the input once and reports, for every item type, how many rucksacks hold it, in how many
+// groups every elf carries it, and how often it is the badge, followed by the most common badge.
+// Usage: `day03_frequencies [input] [elves per group] [threads]`.
+//-------------------------------------------------------------------------------------------------
+
+#include <iostream>
+#include <string>
+#include <stdexcept>
+#include "day03.hpp"
+#include "../utils/mapped_file.hpp"
+
+const std::string FILE_NAME = "input.txt";
+
+int main(int argc, char *argv[])
+{
+  std::string file_name = argc > 1 ? argv[1] : FILE_NAME;
+  size_t elves_per_group = argc > 2 ? std::max<size_t>(1, std::stoull(argv[2])) : ELVES_PER_GROUP;
+  size_t num_threads = argc > 3 ? std::stoull(argv[3]) : utils::get_thread_count();
+
+  try
+  {
+    utils::MappedFile file_handle(file_name);
+    const ItemFrequencies frequencies = sum_priorities_parallel(file_handle.view(), elves_per_group, num_threads).item_frequencies;
+
+    std::cout << "Item\tRucksacks\tGroups\tBadges\n";
+    for (size_t i = 0; i < NUM_ITEM_TYPES; i++)
+    {
+      std::cout << priority_to_item_type((int)i + 1) << "\t" << frequencies.rucksacks[i] << "\t" << frequencies.groups[i] << "\t"
+                << frequencies.badges[i] << "\n";
+    }
+
+    int most_common_badge = frequencies.get_most_common_badge();
+    if (most_common_badge > 0)
+    {
+      std::cout << "Most common badge:\t" << priority_to_item_type(most_common_badge) << " ("
+                << frequencies.badges[most_common_badge - 1] << " groups)\n";
+    }
+  }
+  catch (std::runtime_error &)
+  {
+    return 1;
+  }
+
+  return 0;
+}
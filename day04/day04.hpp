@@ -0,0 +1,231 @@
+#pragma once
+#include <cstdint>
+#include <limits>
+#include <string_view>
+#include <vector>
+#include "../utils/text.hpp"
+
+#if defined(__AVX2__) || defined(__SSE4_1__)
+#include <immintrin.h>
+#endif
+
+const size_t TYPICAL_RECORD_SIZE = 12; // "12-34,56-78\n", used to guess how many pairs an input holds.
+
+/// @brief Counts for both parts of day 4.
+struct AssignmentCounts
+{
+  unsigned int fully_contained_pairs = 0; // Part 1: pairs where one range contains the other.
+  unsigned int overlapping_pairs = 0;     // Part 2: pairs where the ranges overlap at all.
+};
+
+/// @brief The assignment pairs, with each bound in its own array so that many pairs can be compared at once. Pair `i` is the
+/// ranges `first_starts[i]-first_ends[i]` and `second_starts[i]-second_ends[i]`, both inclusive.
+struct AssignmentPairs
+{
+  std::vector<uint32_t> first_starts;
+  std::vector<uint32_t> first_ends;
+  std::vector<uint32_t> second_starts;
+  std::vector<uint32_t> second_ends;
+  size_t num_malformed = 0; // The number of lines that were not assignment pairs, which are skipped.
+
+  size_t size() const
+  {
+    return first_starts.size();
+  }
+
+  void reserve(size_t capacity)
+  {
+    first_starts.reserve(capacity);
+    first_ends.reserve(capacity);
+    second_starts.reserve(capacity);
+    second_ends.reserve(capacity);
+  }
+
+  void add(uint32_t first_start, uint32_t first_end, uint32_t second_start, uint32_t second_end)
+  {
+    first_starts.push_back(first_start);
+    first_ends.push_back(first_end);
+    second_starts.push_back(second_start);
+    second_ends.push_back(second_end);
+  }
+};
+
+/// @return `true` if either range contains the other.
+constexpr bool is_fully_contained(uint32_t first_start, uint32_t first_end, uint32_t second_start, uint32_t second_end)
+{
+  return (first_start <= second_start && second_end <= first_end) || (second_start <= first_start && first_end <= second_end);
+}
+
+/// @return `true` if the ranges share at least one section.
+constexpr bool is_overlapping(uint32_t first_start, uint32_t first_end, uint32_t second_start, uint32_t second_end)
+{
+  return first_start <= second_end && second_start <= first_end;
+}
+
+/// @brief Parses one bound of a range.
+/// @param input The input.
+/// @param i The index to start at. Advanced past the digits.
+/// @param bound Set to the bound.
+/// @return `false` if there are no digits at `i` or the bound does not fit in 32 bits.
+constexpr bool parse_bound(std::string_view input, size_t &i, uint32_t &bound)
+{
+  size_t begin = i;
+  uint64_t value = 0;
+  for (; i < input.size() && utils::is_digit(input[i]) && value <= std::numeric_limits<uint32_t>::max(); i++)
+  {
+    value = value * 10 + (input[i] - '0');
+  }
+  bound = (uint32_t)value;
+  return i > begin && value <= std::numeric_limits<uint32_t>::max();
+}
+
+/// @brief Checks for a delimiter and steps over it.
+/// @return `true` if `input[i]` is the delimiter.
+constexpr bool skip_delimiter(std::string_view input, size_t &i, char delimiter)
+{
+  if (i < input.size() && input[i] == delimiter)
+  {
+    i++;
+    return true;
+  }
+  return false;
+}
+
+/// @brief Reads every assignment pair in a single forward scan, without temporary strings or exceptions. Each record is read
+/// straight off the input; a line that is not of the form "a-b,c-d" with `a <= b` and `c <= d` is counted as malformed and
+/// skipped. Blank lines are ignored. Usable in constant expressions.
+/// @param input The assignment pairs.
+/// @param add_pair Called as `add_pair(first_start, first_end, second_start, second_end)` for each valid pair, in order.
+/// @return The number of malformed lines.
+template <class AddPair>
+constexpr size_t scan_assignment_pairs(std::string_view input, AddPair add_pair)
+{
+  size_t num_malformed = 0;
+  size_t i = 0;
+  while (i < input.size())
+  {
+    if (input[i] == '\n' || input[i] == '\r')
+    {
+      i++;
+      continue;
+    }
+
+    uint32_t first_start = 0, first_end = 0, second_start = 0, second_end = 0;
+    bool is_valid = parse_bound(input, i, first_start) && skip_delimiter(input, i, '-') &&
+                    parse_bound(input, i, first_end) && skip_delimiter(input, i, ',') &&
+                    parse_bound(input, i, second_start) && skip_delimiter(input, i, '-') &&
+                    parse_bound(input, i, second_end);
+    skip_delimiter(input, i, '\r');
+    is_valid = is_valid && (i == input.size() || input[i] == '\n') && first_start <= first_end && second_start <= second_end;
+
+    if (is_valid)
+    {
+      add_pair(first_start, first_end, second_start, second_end);
+    }
+    else
+    {
+      num_malformed++;
+      size_t line_end = input.find('\n', i);
+      i = line_end == std::string_view::npos ? input.size() : line_end;
+    }
+  }
+  return num_malformed;
+}
+
+/// @brief Counts the fully contained and overlapping assignment pairs without allocating. Malformed lines are skipped, exactly as
+/// `load_assignment_pairs` does. Usable in constant expressions.
+/// @param input The assignment pairs: lines of the form "a-b,c-d".
+/// @return The counts.
+constexpr AssignmentCounts count_assignment_pairs(std::string_view input)
+{
+  AssignmentCounts counts;
+  scan_assignment_pairs(input, [&](uint32_t first_start, uint32_t first_end, uint32_t second_start, uint32_t second_end)
+                        {
+                          counts.fully_contained_pairs += is_fully_contained(first_start, first_end, second_start, second_end);
+                          counts.overlapping_pairs += is_overlapping(first_start, first_end, second_start, second_end); });
+  return counts;
+}
+
+/// @brief Reads the assignment pairs into separate arrays of bounds with `scan_assignment_pairs`.
+/// @param input The assignment pairs, e.g. the view of a `utils::MappedFile`.
+/// @return The pairs.
+AssignmentPairs load_assignment_pairs(std::string_view input)
+{
+  AssignmentPairs pairs;
+  pairs.reserve(input.size() / TYPICAL_RECORD_SIZE + 1);
+  pairs.num_malformed = scan_assignment_pairs(input, [&](uint32_t first_start, uint32_t first_end, uint32_t second_start, uint32_t second_end)
+                                              { pairs.add(first_start, first_end, second_start, second_end); });
+  return pairs;
+}
+
+/// @brief Counts the fully contained and overlapping pairs in one sweep over the bounds, comparing 8 (AVX2) or 4 (SSE4.1) pairs
+/// at a time without branching. A compare sets a lane to all ones, so subtracting it counts the lane.
+/// @param pairs The pairs.
+/// @return The counts.
+AssignmentCounts count_assignment_pairs(const AssignmentPairs &pairs)
+{
+  AssignmentCounts counts;
+  size_t i = 0;
+
+#if defined(__AVX2__)
+  // The bounds are unsigned, and x <= y exactly when min(x, y) == x.
+  auto less_equal = [](__m256i x, __m256i y)
+  { return _mm256_cmpeq_epi32(_mm256_min_epu32(x, y), x); };
+  __m256i contained = _mm256_setzero_si256();
+  __m256i overlapping = _mm256_setzero_si256();
+  for (; i + 8 <= pairs.size(); i += 8)
+  {
+    __m256i first_start = _mm256_loadu_si256((const __m256i *)(pairs.first_starts.data() + i));
+    __m256i first_end = _mm256_loadu_si256((const __m256i *)(pairs.first_ends.data() + i));
+    __m256i second_start = _mm256_loadu_si256((const __m256i *)(pairs.second_starts.data() + i));
+    __m256i second_end = _mm256_loadu_si256((const __m256i *)(pairs.second_ends.data() + i));
+
+    __m256i first_contains = _mm256_and_si256(less_equal(first_start, second_start), less_equal(second_end, first_end));
+    __m256i second_contains = _mm256_and_si256(less_equal(second_start, first_start), less_equal(first_end, second_end));
+    contained = _mm256_sub_epi32(contained, _mm256_or_si256(first_contains, second_contains));
+    overlapping = _mm256_sub_epi32(overlapping, _mm256_and_si256(less_equal(first_start, second_end), less_equal(second_start, first_end)));
+  }
+  uint32_t contained_lanes[8];
+  uint32_t overlapping_lanes[8];
+  _mm256_storeu_si256((__m256i *)contained_lanes, contained);
+  _mm256_storeu_si256((__m256i *)overlapping_lanes, overlapping);
+  for (size_t lane = 0; lane < 8; lane++)
+  {
+    counts.fully_contained_pairs += contained_lanes[lane];
+    counts.overlapping_pairs += overlapping_lanes[lane];
+  }
+#elif defined(__SSE4_1__)
+  auto less_equal = [](__m128i x, __m128i y)
+  { return _mm_cmpeq_epi32(_mm_min_epu32(x, y), x); };
+  __m128i contained = _mm_setzero_si128();
+  __m128i overlapping = _mm_setzero_si128();
+  for (; i + 4 <= pairs.size(); i += 4)
+  {
+    __m128i first_start = _mm_loadu_si128((const __m128i *)(pairs.first_starts.data() + i));
+    __m128i first_end = _mm_loadu_si128((const __m128i *)(pairs.first_ends.data() + i));
+    __m128i second_start = _mm_loadu_si128((const __m128i *)(pairs.second_starts.data() + i));
+    __m128i second_end = _mm_loadu_si128((const __m128i *)(pairs.second_ends.data() + i));
+
+    __m128i first_contains = _mm_and_si128(less_equal(first_start, second_start), less_equal(second_end, first_end));
+    __m128i second_contains = _mm_and_si128(less_equal(second_start, first_start), less_equal(first_end, second_end));
+    contained = _mm_sub_epi32(contained, _mm_or_si128(first_contains, second_contains));
+    overlapping = _mm_sub_epi32(overlapping, _mm_and_si128(less_equal(first_start, second_end), less_equal(second_start, first_end)));
+  }
+  uint32_t contained_lanes[4];
+  uint32_t overlapping_lanes[4];
+  _mm_storeu_si128((__m128i *)contained_lanes, contained);
+  _mm_storeu_si128((__m128i *)overlapping_lanes, overlapping);
+  for (size_t lane = 0; lane < 4; lane++)
+  {
+    counts.fully_contained_pairs += contained_lanes[lane];
+    counts.overlapping_pairs += overlapping_lanes[lane];
+  }
+#endif
+
+  for (; i < pairs.size(); i++)
+  {
+    counts.fully_contained_pairs += is_fully_contained(pairs.first_starts[i], pairs.first_ends[i], pairs.second_starts[i], pairs.second_ends[i]);
+    counts.overlapping_pairs += is_overlapping(pairs.first_starts[i], pairs.first_ends[i], pairs.second_starts[i], pairs.second_ends[i]);
+  }
+  return counts;
+}
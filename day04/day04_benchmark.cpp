@@ -0,0 +1,49 @@
+//-------------------------------------------------------------------------------------------------
+// Day 04: Camp Cleanup (throughput benchmark)
+// by Rene Jotham C. Culaway
+//
+// Times the line-by-line text solver against parsing into bound arrays and the SIMD sweep over
+// them, checks that they agree, and reports each one's throughput in GB/s of input.
+//-------------------------------------------------------------------------------------------------
+
+#include <iostream>
+#include <string>
+#include <stdexcept>
+#include "day04.hpp"
+#include "../utils/mapped_file.hpp"
+#include "../utils/benchmark.hpp"
+
+const std::string FILE_NAME = "input.txt";
+const size_t DEFAULT_REPETITIONS = 5;
+
+int main(int argc, char *argv[])
+{
+  std::string file_name = argc > 1 ? argv[1] : FILE_NAME;
+  size_t repetitions = argc > 2 ? std::stoull(argv[2]) : DEFAULT_REPETITIONS;
+
+  try
+  {
+    utils::MappedFile input_file(file_name);
+    std::string_view input = input_file.view();
+
+    AssignmentCounts expected = utils::report_throughput("text solver", input.size(), repetitions, [&]()
+                                                         { return count_assignment_pairs(input); });
+    AssignmentPairs pairs = utils::report_throughput("parse into arrays", input.size(), repetitions, [&]()
+                                                     { return load_assignment_pairs(input); });
+    AssignmentCounts counts = utils::report_throughput("SIMD sweep", input.size(), repetitions, [&]()
+                                                       { return count_assignment_pairs(pairs); });
+
+    std::cout << "Pairs:\t" << pairs.size() << "\tskipped:\t" << pairs.num_malformed << "\n";
+    if (counts.fully_contained_pairs != expected.fully_contained_pairs || counts.overlapping_pairs != expected.overlapping_pairs)
+    {
+      std::cout << "MISMATCH\n";
+      return 1;
+    }
+  }
+  catch (std::runtime_error &)
+  {
+    return 1;
+  }
+
+  return 0;
+}
@@ -0,0 +1,28 @@
+//-------------------------------------------------------------------------------------------------
+// Day 04: Camp Cleanup (compile-time)
+// by Rene Jotham C. Culaway
+//
+// Solves an embedded input entirely at compile time. Generate `input.embedded.hpp` with
+// `embed_input input.txt input.embedded.hpp`, then build with `-DEXPECTED_PART_1=<answer>` and
+// `-DEXPECTED_PART_2=<answer>` to have the answers checked by `static_assert`.
+//-------------------------------------------------------------------------------------------------
+
+#include <iostream>
+#include "day04.hpp"
+#include "input.embedded.hpp"
+
+constexpr AssignmentCounts COUNTS = count_assignment_pairs(EMBEDDED_INPUT);
+
+#ifdef EXPECTED_PART_1
+static_assert(COUNTS.fully_contained_pairs == EXPECTED_PART_1, "Part 1 does not match the expected answer.");
+#endif
+#ifdef EXPECTED_PART_2
+static_assert(COUNTS.overlapping_pairs == EXPECTED_PART_2, "Part 2 does not match the expected answer.");
+#endif
+
+int main(int argc, char *argv[])
+{
+  std::cout << "The fully contained pairs are " << COUNTS.fully_contained_pairs << ".\n";
+  std::cout << "The intersecting pairs are " << COUNTS.overlapping_pairs << ".\n";
+  return 0;
+}
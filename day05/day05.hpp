@@ -0,0 +1,110 @@
+#pragma once
+#include <string_view>
+#include <stdexcept>
+#include "../utils/text.hpp"
+
+const size_t MAX_STACKS = 16;
+const size_t MAX_CRATES = 256;       // The most crates a single stack can hold.
+const size_t MAX_LAYOUT_LINES = 128; // The most lines the starting stack layout can span.
+
+/// @brief The crates on top of each stack after rearranging.
+struct CrateTops
+{
+  char tops[MAX_STACKS] = {};
+  size_t num_stacks = 0;
+
+  constexpr std::string_view view() const
+  {
+    return std::string_view(tops, num_stacks);
+  }
+};
+
+/// @brief Rearranges the crates in fixed-size storage and reads off the top of each stack. Usable in constant expressions.
+/// @param input The puzzle input: the stack layout, a blank line, then the rearrangement procedure.
+/// @param keep_order `false` if the crane moves one crate at a time (part 1), `true` if it moves several at once, keeping their order (part 2).
+/// @return The crates on top of each stack.
+constexpr CrateTops find_top_crates(std::string_view input, bool keep_order)
+{
+  std::string_view layout[MAX_LAYOUT_LINES] = {};
+  size_t num_layout_lines = 0;
+  while (!input.empty())
+  {
+    std::string_view line = utils::next_line(input);
+    if (line.empty())
+    {
+      break;
+    }
+    if (num_layout_lines >= MAX_LAYOUT_LINES)
+    {
+      throw std::length_error("Stack layout is too tall.");
+    }
+    layout[num_layout_lines++] = line;
+  }
+  if (num_layout_lines == 0)
+  {
+    return CrateTops();
+  }
+
+  // The last line of the layout holds the stack labels.
+  size_t num_stacks = (layout[num_layout_lines - 1].size() + 1) / 4;
+  if (num_stacks > MAX_STACKS)
+  {
+    throw std::length_error("Too many stacks.");
+  }
+
+  char stacks[MAX_STACKS][MAX_CRATES] = {};
+  size_t heights[MAX_STACKS] = {};
+  for (size_t line_idx = num_layout_lines - 1; line_idx-- > 0;) // From the bottom up, skipping the labels.
+  {
+    for (size_t stack_idx = 0; stack_idx < num_stacks; stack_idx++)
+    {
+      size_t column = stack_idx * 4 + 1; // Each crate occupies "[X] ".
+      if (column < layout[line_idx].size() && layout[line_idx][column] != ' ')
+      {
+        stacks[stack_idx][heights[stack_idx]++] = layout[line_idx][column];
+      }
+    }
+  }
+
+  while (!input.empty())
+  {
+    std::string_view line = utils::next_line(input);
+
+    // "move <count> from <origin> to <dest>"
+    size_t numbers[3] = {};
+    size_t i = 0;
+    for (size_t &number : numbers)
+    {
+      while (i < line.size() && !utils::is_digit(line[i]))
+      {
+        i++;
+      }
+      number = utils::parse_unsigned(line, i);
+    }
+    size_t count = numbers[0], origin = numbers[1] - 1, dest = numbers[2] - 1; // Subtract 1 due to zero-indexing
+    if (count == 0)
+    {
+      continue;
+    }
+    if (origin >= num_stacks || dest >= num_stacks || count > heights[origin] || heights[dest] + count > MAX_CRATES)
+    {
+      throw std::out_of_range("Invalid rearrangement step.");
+    }
+
+    for (size_t moved = 0; moved < count; moved++)
+    {
+      size_t from = keep_order ? heights[origin] - count + moved : heights[origin] - 1 - moved;
+      stacks[dest][heights[dest] + moved] = stacks[origin][from];
+    }
+    heights[origin] -= count;
+    heights[dest] += count;
+  }
+
+  CrateTops tops;
+  tops.num_stacks = num_stacks;
+  for (size_t stack_idx = 0; stack_idx < num_stacks; stack_idx++)
+  {
+    tops.tops[stack_idx] = heights[stack_idx] > 0 ? stacks[stack_idx][heights[stack_idx] - 1] : ' ';
+  }
+  return tops;
+}
@@ -10,6 +10,7 @@
 #include <string>
 #include <stack>
 #include <vector>
+#include "../utils/pipeline.hpp"
 
 const char *FILE_NAME = "input.txt";
 
@@ -21,33 +22,27 @@ struct RearrangementStep
   int count;  // The number of crates to move (at a time)
 };
 
-/// @brief Parses an input file for the stacks and rearrangement procedure
-/// @param file_name The file name.
-/// @return A pair containing the all of the stacks, as well as the rearrangement procedure.
-std::pair<std::vector<std::stack<char>>, std::vector<RearrangementStep>> load_rearrangement_procedure_from_file(const char *file_name)
+/// @brief Parses the starting stack layout, leaving the file at the first step of the rearrangement procedure.
+/// @param file_handle The open input file.
+/// @return All of the stacks.
+std::vector<std::stack<char>> load_crate_stacks(std::istream &file_handle)
 {
   std::vector<std::stack<char>> stacks;
-  std::vector<RearrangementStep> rearrangement_procedure;
-  std::ifstream file_handle(FILE_NAME);
-
-  if (file_handle.bad())
-  {
-    return std::pair(stacks, rearrangement_procedure);
-  }
-
   std::string current_line = "";
   std::stack<std::string> lines;
-  std::streampos list_line;
   // Find the empty space signifying the end of the stack layout definition
   while (std::getline(file_handle, current_line))
   {
     if (current_line.length() == 0)
     {
-      list_line = file_handle.tellg();
       break;
     }
     lines.push(current_line);
   }
+  if (lines.empty())
+  {
+    return stacks;
+  }
   // Keep note of the number of stacks and add that amount to the list of stacks
   int num_of_stacks = (lines.top().length() + 1) / 4;
   for (int i = 0; i < num_of_stacks; i++)
@@ -78,13 +73,26 @@ std::pair<std::vector<std::stack<char>>, std::vector<RearrangementStep>> load_re
     lines.pop();
   }
 
+  return stacks;
+}
+
+/// @brief Streams the rearrangement procedure, parsing one step at a time.
+/// @param file_handle The input file, positioned after the stack layout.
+/// @return A generator of the steps, in order.
+utils::Generator<RearrangementStep> generate_rearrangement_steps(std::istream &file_handle)
+{
   const std::string rearrangement_step_delimiters[] = {
       "move ",
       "from ",
       "to "};
   // Continue file reading; this time parse the commands
+  std::string current_line;
   while (std::getline(file_handle, current_line))
   {
+    if (current_line.empty())
+    {
+      continue;
+    }
     size_t delimiter_locations[] = {
         0, 0, 0};
 
@@ -109,30 +117,22 @@ std::pair<std::vector<std::stack<char>>, std::vector<RearrangementStep>> load_re
     //     << step.count << ", "
     //     << step.origin << ", "
     //     << step.dest << "\n";
-    rearrangement_procedure.emplace_back(step);
+    co_yield step;
   }
-
-  file_handle.close();
-  return std::pair(stacks, rearrangement_procedure);
 }
 
-/// @brief Rearranges the crates one at a time.
-/// @param crate_stacks A vector of crate stacks.
-/// @param rearrangement_procedure Step-by-step procedure on how to move the crates.
-/// @return A vector of crate stacks, with the crates already moved.
-std::vector<std::stack<char>> rearrange_crates(std::vector<std::stack<char>> crate_stacks, const std::vector<RearrangementStep> &rearrangement_procedure)
+/// @brief Carries out one step of the procedure, moving the crates one at a time.
+/// @param crate_stacks A vector of crate stacks, updated in place.
+/// @param step The step of the procedure to carry out.
+void rearrange_crates(std::vector<std::stack<char>> &crate_stacks, const RearrangementStep &step)
 {
-  for (RearrangementStep step : rearrangement_procedure)
+  for (int current_movement = 0; current_movement < step.count; current_movement++)
   {
-    for (int current_movement = 0; current_movement < step.count; current_movement++)
-    {
-      // Subtract 1 due to zero-indexing
-      char crate = crate_stacks[step.origin - 1].top();
-      crate_stacks[step.origin - 1].pop();
-      crate_stacks[step.dest - 1].push(crate);
-    }
+    // Subtract 1 due to zero-indexing
+    char crate = crate_stacks[step.origin - 1].top();
+    crate_stacks[step.origin - 1].pop();
+    crate_stacks[step.dest - 1].push(crate);
   }
-  return crate_stacks;
 }
 
 /// @brief Concatenates all of the top of stacks onto a single string.
@@ -150,7 +150,15 @@ std::string get_top_of_stacks(const std::vector<std::stack<char>> &stacks)
 
 int main(int argc, char *argv[])
 {
-  std::pair<std::vector<std::stack<char>>, std::vector<RearrangementStep>> stacks = load_rearrangement_procedure_from_file(FILE_NAME);
-  std::cout << "TOS: " << get_top_of_stacks(rearrange_crates(stacks.first, stacks.second)) << "\n";
+  std::ifstream file_handle(FILE_NAME);
+  if (!file_handle.is_open())
+  {
+    return 1;
+  }
+
+  std::vector<std::stack<char>> stacks = load_crate_stacks(file_handle);
+  // The procedure is parsed on this thread while a single worker carries out the steps in order, so it is never held in memory.
+  std::vector<std::vector<std::stack<char>>> rearranged = utils::pipeline_reduce(generate_rearrangement_steps(file_handle), stacks, rearrange_crates, 1);
+  std::cout << "TOS: " << get_top_of_stacks(rearranged.front()) << "\n";
   return 0;
 }
\ No newline at end of file
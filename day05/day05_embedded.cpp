@@ -0,0 +1,29 @@
+//-------------------------------------------------------------------------------------------------
+// Day 05: Supply Stacks (compile-time)
+// by Rene Jotham C. Culaway
+//
+// Solves an embedded input entirely at compile time. Generate `input.embedded.hpp` with
+// `embed_input input.txt input.embedded.hpp`, then build with `-DEXPECTED_PART_1='"<answer>"'` and
+// `-DEXPECTED_PART_2='"<answer>"'` to have the answers checked by `static_assert`.
+//-------------------------------------------------------------------------------------------------
+
+#include <iostream>
+#include "day05.hpp"
+#include "input.embedded.hpp"
+
+constexpr CrateTops TOPS = find_top_crates(EMBEDDED_INPUT, false);
+constexpr CrateTops TOPS_IN_ORDER = find_top_crates(EMBEDDED_INPUT, true);
+
+#ifdef EXPECTED_PART_1
+static_assert(TOPS.view() == EXPECTED_PART_1, "Part 1 does not match the expected answer.");
+#endif
+#ifdef EXPECTED_PART_2
+static_assert(TOPS_IN_ORDER.view() == EXPECTED_PART_2, "Part 2 does not match the expected answer.");
+#endif
+
+int main(int argc, char *argv[])
+{
+  std::cout << "TOS: " << TOPS.view() << "\n";
+  std::cout << "TOS (keeping order): " << TOPS_IN_ORDER.view() << "\n";
+  return 0;
+}
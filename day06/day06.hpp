@@ -0,0 +1,28 @@
+#pragma once
+#include <string_view>
+
+/// @brief Finds where the first window of `window_size` distinct characters ends, without allocating. Usable in constant expressions.
+/// @param input The datastream buffer.
+/// @param window_size The window size.
+/// @return The number of characters processed once the window is complete, or 0 if there is no such window.
+constexpr size_t find_first_start_of_packet(std::string_view input, size_t window_size)
+{
+  size_t last_seen[256] = {}; // One past the last index where each character was seen; 0 if not yet seen.
+  size_t window_start = 0;    // The start of the current run of distinct characters.
+
+  for (size_t i = 0; i < input.size(); i++)
+  {
+    unsigned char c = input[i];
+    if (last_seen[c] > window_start)
+    {
+      window_start = last_seen[c];
+    }
+    last_seen[c] = i + 1;
+
+    if (i + 1 - window_start >= window_size)
+    {
+      return i + 1;
+    }
+  }
+  return 0;
+}
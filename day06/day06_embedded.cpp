@@ -0,0 +1,32 @@
+//-------------------------------------------------------------------------------------------------
+// Day 06: Tuning Trouble (compile-time)
+// by Rene Jotham C. Culaway
+//
+// Solves an embedded input entirely at compile time. Generate `input.embedded.hpp` with
+// `embed_input input.txt input.embedded.hpp`, then build with `-DEXPECTED_PART_1=<answer>` and
+// `-DEXPECTED_PART_2=<answer>` to have the answers checked by `static_assert`.
+//-------------------------------------------------------------------------------------------------
+
+#include <iostream>
+#include "day06.hpp"
+#include "input.embedded.hpp"
+
+const size_t WINDOW_SIZE = 4;
+const size_t WINDOW_SIZE_2 = 14;
+
+constexpr size_t START_OF_PACKET = find_first_start_of_packet(EMBEDDED_INPUT, WINDOW_SIZE);
+constexpr size_t START_OF_MESSAGE = find_first_start_of_packet(EMBEDDED_INPUT, WINDOW_SIZE_2);
+
+#ifdef EXPECTED_PART_1
+static_assert(START_OF_PACKET == EXPECTED_PART_1, "Part 1 does not match the expected answer.");
+#endif
+#ifdef EXPECTED_PART_2
+static_assert(START_OF_MESSAGE == EXPECTED_PART_2, "Part 2 does not match the expected answer.");
+#endif
+
+int main(int argc, char *argv[])
+{
+  std::cout << START_OF_PACKET << "\n";
+  std::cout << START_OF_MESSAGE << "\n";
+  return 0;
+}
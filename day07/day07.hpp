@@ -4,12 +4,21 @@
 #include <string>
 #include <fstream>
 #include <stack>
+#include <string_view>
+#include "../utils/small_vector.hpp"
+#include "../utils/string_interner.hpp"
 
 class Node;
 class File;
 class Directory;
 class Filesystem;
 
+/// Node names repeat a lot across a transcript (`a`, `d.log`, ...), so each distinct name is stored only once, here.
+utils::StringInterner node_names;
+
+/// Most directories only hold a handful of children, which then fit without a heap allocation.
+using NodeList = utils::SmallVector<std::shared_ptr<Node>, 4>;
+
 /**
  * Since we are dealing with a "filesystem", it's best to represent it as a tree.
  * */
@@ -18,7 +27,7 @@ class Filesystem;
 class Node
 {
 protected:
-  std::string name;
+  std::string_view name; // Points into `node_names`.
   std::shared_ptr<Directory> parent;
 
 public:
@@ -28,7 +37,7 @@ public:
 
   /// @brief Returns the name of the node.
   /// @return The name of the node.
-  const std::string get_name()
+  std::string_view get_name()
   {
     return name;
   }
@@ -61,7 +70,7 @@ public:
   /// @brief Displays node information.
   virtual void print_node() = 0;
 
-  Node(std::string name, std::shared_ptr<Directory> parent = nullptr) : name(name)
+  Node(std::string_view name, std::shared_ptr<Directory> parent = nullptr) : name(node_names.intern_view(name))
   {
     this->parent = parent;
   }
@@ -71,10 +80,10 @@ public:
 class Directory : public Node
 {
 private:
-  std::vector<std::shared_ptr<Node>> children; // Each child is part of a vector.
+  NodeList children; // Each child is part of a (small) vector.
 
 public:
-  Directory(std::string name, std::shared_ptr<Directory> parent = nullptr) : Node(name, parent)
+  Directory(std::string_view name, std::shared_ptr<Directory> parent = nullptr) : Node(name, parent)
   {
   }
 
@@ -90,7 +99,7 @@ public:
     return file_size;
   }
 
-  const std::string get_name()
+  std::string_view get_name()
   {
     return this->name;
   }
@@ -109,7 +118,7 @@ public:
 
   /// @brief Gets the children of this Node.
   /// @return A vector containing this Node's children.
-  const std::vector<std::shared_ptr<Node>> &get_children()
+  const NodeList &get_children()
   {
     return children;
   }
@@ -128,7 +137,7 @@ private:
   unsigned int file_size = 0;
 
 public:
-  File(std::string name, std::shared_ptr<Directory> parent = nullptr, unsigned int size = 0) : Node(name, parent), file_size(size)
+  File(std::string_view name, std::shared_ptr<Directory> parent = nullptr, unsigned int size = 0) : Node(name, parent), file_size(size)
   {
   }
 
@@ -139,7 +148,7 @@ public:
     return file_size;
   }
 
-  const std::string get_name()
+  std::string_view get_name()
   {
     return this->name;
   }
@@ -3,6 +3,8 @@
 #include <string>
 #include <queue>
 #include <functional>
+#include <string_view>
+#include "../utils/text.hpp"
 
 /// @brief A class representing a Command. I tried to implement here a (crude) version of the Command pattern.
 class Command
@@ -208,4 +210,71 @@ void parse_commands(const char *&file_name, CathodeRayTube &crt)
 
   file_handle.close();
   return;
+}
+
+const int SCREEN_WIDTH = 40;
+const int SCREEN_HEIGHT = 6;
+
+/// @brief What the CRT produces after running a program.
+struct CrtOutput
+{
+  int combined_signal_strength = 0;
+  char screen[SCREEN_HEIGHT * (SCREEN_WIDTH + 1)] = {}; // Each row of pixels is followed by a newline.
+
+  constexpr std::string_view view() const
+  {
+    return std::string_view(screen, sizeof(screen));
+  }
+};
+
+/// @brief Runs the CRT over a program without a command queue or allocations. Usable in constant expressions.
+/// @param input The program: one "noop" or "addx <value>" per line.
+/// @return The combined signal strength and the drawn screen.
+constexpr CrtOutput run_crt(std::string_view input)
+{
+  CrtOutput output;
+  for (char &pixel : output.screen)
+  {
+    pixel = '.';
+  }
+  for (int row = 0; row < SCREEN_HEIGHT; row++)
+  {
+    output.screen[row * (SCREEN_WIDTH + 1) + SCREEN_WIDTH] = '\n';
+  }
+
+  int cycle = 1;
+  int _register = 1;
+  // Draws the pixel for the current cycle, then advances the clock.
+  auto tick = [&]()
+  {
+    int column = (cycle - 1) % SCREEN_WIDTH;
+    int row = (cycle - 1) / SCREEN_WIDTH;
+    if (row < SCREEN_HEIGHT && column >= _register - 1 && column <= _register + 1)
+    {
+      output.screen[row * (SCREEN_WIDTH + 1) + column] = '#';
+    }
+    if ((cycle - 20) % SCREEN_WIDTH == 0)
+    {
+      output.combined_signal_strength += cycle * _register;
+    }
+    cycle++;
+  };
+
+  while (!input.empty())
+  {
+    std::string_view line = utils::next_line(input);
+    if (line.substr(0, 4) == "noop")
+    {
+      tick();
+    }
+    else if (line.substr(0, 4) == "addx")
+    {
+      size_t i = 5;
+      int operand = (int)utils::parse_signed(line, i);
+      tick();
+      tick();
+      _register += operand;
+    }
+  }
+  return output;
 }
\ No newline at end of file
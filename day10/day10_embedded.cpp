@@ -0,0 +1,28 @@
+//-------------------------------------------------------------------------------------------------
+// Day 10: Cathode-Ray Tube (compile-time)
+// by Rene Jotham C. Culaway
+//
+// Solves an embedded input entirely at compile time. Generate `input.embedded.hpp` with
+// `embed_input input.txt input.embedded.hpp`, then build with `-DEXPECTED_PART_1=<answer>` and
+// `-DEXPECTED_PART_2=<answer>` to have the answers checked by `static_assert`.
+//-------------------------------------------------------------------------------------------------
+
+#include <iostream>
+#include "day10.hpp"
+#include "input.embedded.hpp"
+
+constexpr CrtOutput OUTPUT = run_crt(EMBEDDED_INPUT);
+
+#ifdef EXPECTED_PART_1
+static_assert(OUTPUT.combined_signal_strength == EXPECTED_PART_1, "Part 1 does not match the expected answer.");
+#endif
+#ifdef EXPECTED_PART_2
+static_assert(OUTPUT.view() == EXPECTED_PART_2, "Part 2 does not match the expected answer.");
+#endif
+
+int main(int argc, char *argv[])
+{
+  std::cout << OUTPUT.view();
+  std::cout << OUTPUT.combined_signal_strength << std::endl;
+  return 0;
+}
@@ -7,13 +7,16 @@
 #include <algorithm>
 #include <string>
 #include "../utils/utils.hpp"
+#include "../utils/small_vector.hpp"
+
+const size_t INLINE_ITEMS = 16; // Monkeys rarely hold more items than this at once.
 
 /// @brief A class representing a Monkey.
 class Monkey
 {
   int id;
   unsigned long long activity = 0;                         // How many times this monkey has looked through an item.
-  std::vector<unsigned long long> items;                   // The items (or their worry levels) that the monkey holds.
+  utils::SmallVector<unsigned long long, INLINE_ITEMS> items; // The items (or their worry levels) that the monkey holds.
   const std::function<void(unsigned long long &)> inspect; // Function that modifies an item's worry level.
   unsigned long long divisor;                              // This monkey's divisor.
 
@@ -31,7 +34,7 @@ public:
          unsigned long long divisor,
          std::pair<int, int> other_monkeys,
          std::vector<unsigned long long> starting_items)
-      : id(id), inspect(inspect), divisor(divisor), other_monkeys(other_monkeys), items{starting_items}
+      : id(id), inspect(inspect), divisor(divisor), other_monkeys(other_monkeys), items(starting_items.begin(), starting_items.end())
   {
   }
 
@@ -241,9 +244,10 @@ public:
 /// @param out Where to output the current state of the monkey.
 void Monkey::go_through_items(MonkeyParty *monkeyparty, const unsigned long long &worry_divisor, std::ostream *out)
 {
-  while (!items.empty())
+  // Every item is thrown away, so go through them in order and drop them all at the end, rather than erasing from the front.
+  for (size_t i = 0; i < items.size(); i++)
   {
-    auto item = items.front();
+    auto item = items[i];
     // if (out != nullptr)
     // {
     //   *out << "\tMonkey inspects an item with a worry level of " << item << "." << std::endl;
@@ -265,7 +269,7 @@ void Monkey::go_through_items(MonkeyParty *monkeyparty, const unsigned long long
     //   *out << "\t\tItem with worry level " << item << " is thrown to monkey " << monkey_to_throw_to << "." << std::endl;
     // }
     (*monkeyparty).throw_item_to_monkey(monkey_to_throw_to, item);
-    items.erase(items.begin());
     ++activity;
   }
+  items.clear();
 }
@@ -9,21 +9,83 @@
 // https://www.redblobgames.com/pathfinding/a-star/introduction.html for the refresher on A*.
 //-------------------------------------------------------------------------------------------------
 
+#include <optional>
+#include <sstream>
 #include "day12.hpp"
+#include "../utils/result_cache.hpp"
+#include "../utils/mapped_file.hpp"
+#include "../utils/buffer.hpp"
 
 const std::string FILE_NAME = "input.txt";
+const std::string OUTPUT_FILE_NAME = "output.txt";
+const int DAY = 12;
+const int SCENIC_PATH_MAP_PART = 3; // Where the map written to OUTPUT_FILE_NAME is cached, next to the answers of parts 1 and 2.
+const size_t DEFAULT_BENCHMARK_MEGABYTES = 256;
 
 int main(int argc, char *argv[])
 {
-  HillClimber hill_climber(FILE_NAME);
-  hill_climber.print_map(&std::cout);
-  auto path = hill_climber.get_path();
+  // `--bench-alloc [megabytes]` compares huge-page-backed buffers against plain `new` instead of solving.
+  if (argc > 1 && std::string(argv[1]) == "--bench-alloc")
+  {
+    size_t megabytes = argc > 2 ? std::stoull(argv[2]) : DEFAULT_BENCHMARK_MEGABYTES;
+    utils::benchmark_page_policies(megabytes << 20);
+    return 0;
+  }
+
+  // Searching from every 'a' is slow, so answers for inputs we have already seen are taken from the cache. The input is hashed
+  // straight from its memory mapping, and only parsed if something is not cached.
+  utils::MappedFile input(FILE_NAME);
+  uint64_t input_hash = utils::hash_contents(input.view());
+  utils::ResultCache cache;
+
+  // The same as `HillClimber::print_map`, without parsing.
+  std::cout << input.view();
+  if (!input.view().empty() && input.view().back() != '\n')
+  {
+    std::cout << std::endl;
+  }
+
+  std::optional<HillClimber> hill_climber;
+  std::optional<std::stack<Coordinate>> scenic_path; // Shared by part 2 and its map, so it is searched for at most once.
+  auto get_hill_climber = [&]() -> HillClimber &
+  {
+    if (!hill_climber)
+    {
+      hill_climber.emplace(FILE_NAME);
+    }
+    return *hill_climber;
+  };
+  auto get_scenic_path = [&]() -> const std::stack<Coordinate> &
+  {
+    if (!scenic_path)
+    {
+      scenic_path = get_hill_climber().get_scenic_path();
+    }
+    return *scenic_path;
+  };
+
+  auto path_length = utils::cached_solve(cache, DAY, 1, input_hash, [&]()
+                                         { return get_hill_climber().get_path().size(); });
+  auto scenic_path_length = utils::cached_solve(cache, DAY, 2, input_hash, [&]()
+                                                { return get_scenic_path().size(); });
+  // The map of the scenic path is cached under the same input hash, so output.txt always matches this input.
+  auto scenic_path_map = utils::cached_solve(cache, DAY, SCENIC_PATH_MAP_PART, input_hash, [&]()
+                                             {
+                                               std::ostringstream scenic_path_map;
+                                               get_hill_climber().print_path_map(get_scenic_path(), &scenic_path_map);
+                                               return scenic_path_map.str(); });
+
+  std::ofstream output_file_handle(OUTPUT_FILE_NAME);
+  output_file_handle << scenic_path_map.answer;
 
   // while (!path.empty())
   // {
   //   std::cout << path.top().first << ", " << path.top().second << std::endl;
   //   path.pop();
   // }
-  hill_climber.print_path_map(hill_climber.get_scenic_path(), &std::ofstream("output.txt"));
+  std::cout << "Path length: " << path_length.answer << (path_length.is_hit ? " (cached, " : " (")
+            << path_length.nanoseconds << " ns)" << std::endl;
+  std::cout << "Scenic path length: " << scenic_path_length.answer << (scenic_path_length.is_hit ? " (cached, " : " (")
+            << scenic_path_length.nanoseconds << " ns)" << std::endl;
   return 0;
 }
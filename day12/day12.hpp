@@ -1,5 +1,7 @@
 #pragma once
 #include "../utils/utils.hpp"
+#include "../utils/indexed_heap.hpp"
+#include "../utils/buffer.hpp"
 #include <fstream>
 #include <string>
 #include <memory>
@@ -8,10 +10,13 @@
 #include <stack>
 #include <functional>
 #include <set>
+#include <limits>
 
 /// @brief Type alias for this one cuz it gets tiring typing this one out.
 using Coordinate = std::pair<size_t, size_t>;
 
+const unsigned int MAX_STEP_COST = 'z' - 'a' + 1;
+
 /// @brief For printing.
 enum MapLegend
 {
@@ -176,27 +181,11 @@ private:
     return std::abs((int)c1.first - (int)c2.first) + std::abs((int)c1.second - (int)c2.second);
   }
 
-public:
-  /// @brief Reads an input file.
-  HillClimber(const std::string &file_name)
+  /// @brief Finds the size of the map and where the start and end are.
+  void locate_endpoints()
   {
-    std::ifstream file_handle(file_name);
-
-    if (!file_handle.is_open())
-    {
-      return;
-    }
-
-    std::string current_line;
-    while (std::getline(file_handle, current_line))
-    {
-      map.emplace_back(current_line);
-    }
-
-    file_handle.close();
-
     height = map.size();
-    width = map[0].size();
+    width = height > 0 ? map[0].size() : 0;
 
     for (size_t i = 0; i < height; i++)
     {
@@ -216,10 +205,92 @@ public:
         }
       }
     }
+  }
 
+  /// @brief The A* search behind `get_path` and `get_path_heap`.
+  /// @param starting_position The starting position.
+  /// @param frontier An empty queue over the 1D cell indices, with `push_or_decrease`, `pop` and `is_empty`.
+  /// @return A stack of coordinates to move to to get to the endpoint.
+  template <class Frontier>
+  std::stack<Coordinate> search_path(const Coordinate &starting_position, Frontier &frontier)
+  {
+    const size_t num_cells = width * height;
+    // Single-threaded search, so the buffers are first touched by this thread alone. Each buffer picks its page policy from its own size.
+    utils::LargeBuffer<int> costs(num_cells, utils::default_page_policy(num_cells * sizeof(int)), 1); // The current minimum cost to get to each cell.
+    utils::LargeBuffer<size_t> from(num_cells, utils::default_page_policy(num_cells * sizeof(size_t)), 1); // The preceding cell of each cell.
+    utils::LargeBuffer<bool> is_expanded(num_cells, utils::default_page_policy(num_cells * sizeof(bool)), 1);
+    std::fill(costs.begin(), costs.end(), std::numeric_limits<int>::max());
+    std::stack<Coordinate> path; // The final path.
+
+    size_t starting_id = utils::index_2d_to_1d(starting_position.second, starting_position.first, width);
+    costs[starting_id] = 0;
+    from[starting_id] = starting_id;
+    frontier.push_or_decrease(starting_id, heuristic_distance(end, starting_position));
+
+    while (!frontier.is_empty())
+    {
+      size_t current_id = frontier.pop();
+      is_expanded[current_id] = true;
+      Coordinate current_coordinate = utils::index_1d_to_2d(current_id, width);
+
+      if (is_goal(current_coordinate))
+      {
+        size_t current_path = current_id;
+        while (current_path != starting_id)
+        {
+          // Build the path
+          path.push(utils::index_1d_to_2d(current_path, width));
+          current_path = from[current_path];
+        }
+
+        break;
+      }
+
+      for (auto next : enumerate_valid_adjacents(current_coordinate))
+      {
+        size_t next_id = utils::index_2d_to_1d(next.second, next.first, width);
+        int next_cost = costs[current_id] + compute_cost(next);
+
+        if (!is_expanded[next_id] && next_cost < costs[next_id])
+        {
+          costs[next_id] = next_cost;
+          from[next_id] = current_id;
+          frontier.push_or_decrease(next_id, next_cost + heuristic_distance(end, next));
+        }
+      }
+    }
+    return path;
+  }
+
+public:
+  /// @brief Reads an input file.
+  HillClimber(const std::string &file_name)
+  {
+    std::ifstream file_handle(file_name);
+
+    if (!file_handle.is_open())
+    {
+      return;
+    }
+
+    std::string current_line;
+    while (std::getline(file_handle, current_line))
+    {
+      map.emplace_back(current_line);
+    }
+
+    file_handle.close();
+
+    locate_endpoints();
     return;
   }
 
+  /// @brief Uses an already-loaded map.
+  HillClimber(const std::vector<std::string> &rows) : map(rows)
+  {
+    locate_endpoints();
+  }
+
   /// @brief Prints out the read map.
   /// @param out Where to output the map.
   void print_map(std::ostream *out)
@@ -268,10 +339,56 @@ public:
     return get_path(start);
   }
 
-  /// @brief Computes the shortest path from a set location to the end. A modified implementation of the A* algorithm.
+  std::stack<Coordinate> get_path_heap()
+  {
+    return get_path_heap(start);
+  }
+
+  std::stack<Coordinate> get_path_reference()
+  {
+    return get_path_reference(start);
+  }
+
+  /// @brief Computes the total climbing cost of a path.
+  /// @param path The path, as returned by `get_path`.
+  /// @return The sum of the costs of every step.
+  int get_path_cost(std::stack<Coordinate> path)
+  {
+    int cost = 0;
+    while (!path.empty())
+    {
+      cost += compute_cost(path.top());
+      path.pop();
+    }
+    return cost;
+  }
+
+  /// @brief Computes the shortest path from a set location to the end with A*. Each cell is identified by its 1D index, and the frontier
+  /// is a bucket queue with decrease-key, so every cell is queued at most once and expanded at most once.
   /// @param starting_position The starting position. Default is the input-file-specified start.
   /// @return A stack of coordinates to move to to get to the endpoint.
   std::stack<Coordinate> get_path(const Coordinate &starting_position)
+  {
+    // A step changes the cost by at most MAX_STEP_COST and the Manhattan heuristic by at most 1.
+    utils::BucketQueue frontier(width * height, MAX_STEP_COST + 2);
+    return search_path(starting_position, frontier);
+  }
+
+  /// @brief Same as `get_path`, but the frontier is an indexed binary heap with O(log n) decrease-key. It is slower, but unlike the bucket
+  /// queue it makes no assumption about how much a priority can change along a step.
+  /// @param starting_position The starting position.
+  /// @return A stack of coordinates to move to to get to the endpoint.
+  std::stack<Coordinate> get_path_heap(const Coordinate &starting_position)
+  {
+    utils::IndexedMinHeap<int> frontier(width * height);
+    return search_path(starting_position, frontier);
+  }
+
+  /// @brief The original implementation of `get_path`, kept as the reference for differential checks.
+  /// It keeps its frontier in a `std::priority_queue` ordered by the live `costs` map, and pushes duplicates instead of decreasing keys.
+  /// @param starting_position The starting position.
+  /// @return A stack of coordinates to move to to get to the endpoint.
+  std::stack<Coordinate> get_path_reference(const Coordinate &starting_position)
   {
     std::map<Coordinate, Coordinate> from; // Stores the preceding position from a coordinate.
     std::map<Coordinate, int> costs;       // Stores the current minimum cost to get to a location.
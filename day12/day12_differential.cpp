@@ -0,0 +1,144 @@
+//-------------------------------------------------------------------------------------------------
+// Day 12: Hill Climbing Algorithm (differential check)
+// by Rene Jotham C. Culaway
+//
+// Runs the original `get_path` (now `get_path_reference`) against the bucket-queue `get_path` and
+// the indexed-heap `get_path_heap` on the same randomly generated height maps, checks that they
+// find paths of the same cost, and reports how much faster each new one is.
+//-------------------------------------------------------------------------------------------------
+
+#include "day12.hpp"
+#include "../utils/differential.hpp"
+#include <algorithm>
+
+const size_t DEFAULT_NUM_CASES = 2000;
+const size_t MIN_SIDE = 14; // A path must take at least 26 steps to climb from 'a' to 'z', and the ramp spans width + height - 2.
+const size_t MAX_SIDE = 48;
+const int MAX_NOISE = 2;
+
+using height_map = std::vector<std::string>;
+
+/// @brief Generates a random height map that can always be climbed from the start to the end.
+/// Elevation rises with `i + j` by at most one per step until it reaches 'z', with noise everywhere except along the top row and
+/// the right column, which form a climbable ramp from the start in the top left to the end in the bottom right. The noise makes
+/// walls and pits to go around, so the shortest path often leaves the ramp.
+/// @param rng The random number generator.
+/// @return The map's rows.
+height_map generate_height_map(std::mt19937_64 &rng)
+{
+  size_t width = MIN_SIDE + rng() % (MAX_SIDE - MIN_SIDE + 1);
+  size_t height = MIN_SIDE + rng() % (MAX_SIDE - MIN_SIDE + 1);
+
+  height_map rows(height, std::string(width, 'a'));
+  for (size_t i = 0; i < height; i++)
+  {
+    for (size_t j = 0; j < width; j++)
+    {
+      bool is_ramp = i == 0 || j == width - 1;
+      int elevation = (int)(i + j) + (is_ramp ? 0 : (int)(rng() % (2 * MAX_NOISE + 1)) - MAX_NOISE);
+      rows[i][j] = (char)('a' + std::clamp(elevation, 0, 25));
+    }
+  }
+
+  // The end costs as much as 'z', and the cell before it on the ramp is at 'z' since width + height - 3 >= 25.
+  rows[0][0] = 'S';
+  rows[height - 1][width - 1] = 'E';
+  return rows;
+}
+
+/// @brief Produces smaller variants of a map by removing one row or one column that holds neither the start nor the end.
+/// @param rows The map's rows.
+/// @return The variants.
+std::vector<height_map> shrink_height_map(const height_map &rows)
+{
+  std::vector<height_map> variants;
+  auto is_endpoint = [](char c)
+  { return c == 'S' || c == 'E'; };
+
+  for (size_t i = 0; i < rows.size() && rows.size() > 1; i++)
+  {
+    if (std::none_of(rows[i].begin(), rows[i].end(), is_endpoint))
+    {
+      height_map variant = rows;
+      variant.erase(variant.begin() + i);
+      variants.emplace_back(variant);
+    }
+  }
+
+  for (size_t j = 0; j < rows[0].size() && rows[0].size() > 1; j++)
+  {
+    if (std::none_of(rows.begin(), rows.end(), [&](const std::string &row)
+                     { return is_endpoint(row[j]); }))
+    {
+      height_map variant = rows;
+      for (auto &row : variant)
+        row.erase(j, 1);
+      variants.emplace_back(variant);
+    }
+  }
+  return variants;
+}
+
+/// @brief Finds a path with one of the `HillClimber` searches.
+/// @param rows The map's rows.
+/// @param get_path Called as `get_path(HillClimber &)`.
+/// @return Whether the path is empty, and its cost. Compare the cost, not the path itself, since equally cheap paths may be found in either order.
+template <class GetPath>
+std::pair<bool, int> solve_height_map(const height_map &rows, GetPath get_path)
+{
+  HillClimber hill_climber(rows);
+  auto path = get_path(hill_climber);
+  return std::pair<bool, int>(path.empty(), hill_climber.get_path_cost(path));
+}
+
+void print_height_map(std::ostream &out, const height_map &rows)
+{
+  for (auto &row : rows)
+    out << row << "\n";
+}
+
+int main(int argc, char *argv[])
+{
+  size_t num_cases = argc > 1 ? std::stoull(argv[1]) : DEFAULT_NUM_CASES;
+
+  // Both runs use the same seed and so the same maps; the paths found are counted in the first.
+  size_t num_paths_found = 0;
+  auto bucket_report = utils::run_differential(
+      "HillClimber::get_path", num_cases, generate_height_map,
+      [&](const height_map &rows)
+      {
+        auto answer = solve_height_map(rows, [](HillClimber &hill_climber)
+                                       { return hill_climber.get_path_reference(); });
+        num_paths_found += !answer.first;
+        return answer;
+      },
+      [](const height_map &rows)
+      {
+        return solve_height_map(rows, [](HillClimber &hill_climber)
+                                { return hill_climber.get_path(); });
+      },
+      shrink_height_map, print_height_map);
+  auto heap_report = utils::run_differential(
+      "HillClimber::get_path_heap", num_cases, generate_height_map,
+      [](const height_map &rows)
+      {
+        return solve_height_map(rows, [](HillClimber &hill_climber)
+                                { return hill_climber.get_path_reference(); });
+      },
+      [](const height_map &rows)
+      {
+        return solve_height_map(rows, [](HillClimber &hill_climber)
+                                { return hill_climber.get_path_heap(); });
+      },
+      shrink_height_map, print_height_map);
+
+  std::cout << "Maps with a path: " << num_paths_found << "\n";
+
+  // Comparing empty paths proves nothing, so a run where no map could be climbed fails too.
+  if (num_cases > 0 && num_paths_found == 0)
+  {
+    std::cout << "No generated map had a path.\n";
+    return 1;
+  }
+  return bucket_report.num_mismatches == 0 && heap_report.num_mismatches == 0 ? 0 : 1;
+}
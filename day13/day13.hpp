@@ -4,8 +4,10 @@
 #include <optional>
 #include <set>
 #include <functional>
+#include <string_view>
 
 #include "../utils/utils.hpp"
+#include "../utils/small_vector.hpp"
 
 using packet = std::string; // Type alias to maintain my sanity
 
@@ -68,10 +70,10 @@ std::optional<std::pair<size_t, size_t>> get_next(const packet &pckt, size_t sta
 
 /// @brief Enumerates the subpackets of a (sub)packet.
 /// @param packet The parent packet.
-/// @return A vector containing the subpackets.
-std::vector<packet> get_subpackets(const packet &packet)
+/// @return A vector containing the subpackets. Most lists are short, so they are usually kept inline.
+utils::SmallVector<packet, 8> get_subpackets(const packet &packet)
 {
-  std::vector<std::string> subpackets;
+  utils::SmallVector<std::string, 8> subpackets;
   int i = 0;
   auto next = get_next(packet, i);
   while (next.has_value())
@@ -91,7 +93,7 @@ bool islist(const packet &subpacket)
   return subpacket.at(0) == '[';
 }
 
-/// @brief Compares two packets.
+/// @brief Compares two packets. This is the original, substring-based implementation, kept as the reference for `compare_packets_fast`.
 /// @param left The first packet.
 /// @param right The second packet.
 /// @return `GREATER` if the left packet is greater than the right packet. `LESSER` if the left packet is lesser than the right, and so on.
@@ -162,6 +164,101 @@ ComparisonResult compare_packets(const packet &left, const packet &right)
   return EQUAL;
 }
 
+/// @brief Compares the elements starting at `left[i]` and `right[j]` in place, advancing both indices past the compared elements.
+/// Once the result is not `EQUAL`, the indices are left wherever the comparison stopped.
+/// @param left The first packet.
+/// @param i The index of the first packet's element.
+/// @param right The second packet.
+/// @param j The index of the second packet's element.
+/// @return The result of the comparison.
+ComparisonResult compare_elements(std::string_view left, size_t &i, std::string_view right, size_t &j)
+{
+  bool is_left_list = left[i] == '[';
+  bool is_right_list = right[j] == '[';
+
+  // Both are numbers.
+  if (!is_left_list && !is_right_list)
+  {
+    int left_value = 0, right_value = 0;
+    for (; i < left.size() && std::isdigit(left[i]); i++)
+    {
+      left_value = left_value * 10 + (left[i] - '0');
+    }
+    for (; j < right.size() && std::isdigit(right[j]); j++)
+    {
+      right_value = right_value * 10 + (right[j] - '0');
+    }
+    return left_value > right_value ? GREATER : left_value < right_value ? LESSER
+                                                                         : EQUAL;
+  }
+
+  // Only one is a list, so the number is compared as if it were a list containing only itself.
+  if (is_left_list != is_right_list)
+  {
+    std::string_view &list = is_left_list ? left : right;
+    size_t &list_i = is_left_list ? i : j;
+    ComparisonResult list_longer = is_left_list ? GREATER : LESSER;
+    ComparisonResult list_shorter = is_left_list ? LESSER : GREATER;
+
+    list_i++;
+    if (list[list_i] == ']')
+    {
+      return list_shorter;
+    }
+    ComparisonResult comparison = compare_elements(left, i, right, j);
+    if (comparison != EQUAL)
+    {
+      return comparison;
+    }
+    if (list[list_i] != ']')
+    {
+      return list_longer;
+    }
+    list_i++;
+    return EQUAL;
+  }
+
+  // Both are lists.
+  i++;
+  j++;
+  while (true)
+  {
+    bool is_left_done = left[i] == ']';
+    bool is_right_done = right[j] == ']';
+    if (is_left_done || is_right_done)
+    {
+      if (is_left_done && is_right_done)
+      {
+        i++;
+        j++;
+        return EQUAL;
+      }
+      return is_left_done ? LESSER : GREATER;
+    }
+
+    ComparisonResult comparison = compare_elements(left, i, right, j);
+    if (comparison != EQUAL)
+    {
+      return comparison;
+    }
+
+    if (left[i] == ',')
+      i++;
+    if (right[j] == ',')
+      j++;
+  }
+}
+
+/// @brief Compares two packets without building any subpackets, by walking both strings at once.
+/// @param left The first packet.
+/// @param right The second packet.
+/// @return `GREATER` if the left packet is greater than the right packet. `LESSER` if the left packet is lesser than the right, and so on.
+ComparisonResult compare_packets_fast(std::string_view left, std::string_view right)
+{
+  size_t i = 0, j = 0;
+  return compare_elements(left, i, right, j);
+}
+
 /// @brief Loads packets from a file.
 /// @param file_name The file name.
 /// @return A vector of packets.
@@ -192,7 +289,7 @@ std::vector<packet> load_packets_from_file(const std::string &file_name)
 std::set<packet, std::function<bool(const packet &, const packet &)>> load_sorted_packets_from_file(const std::string &file_name)
 {
   std::function<bool(const packet &, const packet &)> compare = [](const packet &left, const packet &right)
-  { return compare_packets(left, right) == LESSER; };
+  { return compare_packets_fast(left, right) == LESSER; };
   std::set<packet, decltype(compare)> packets(compare);
   std::ifstream file_handle(file_name);
 
@@ -252,7 +349,7 @@ std::vector<bool> process_packets(std::vector<packet> packets)
   int i = 0;
   for (i = 0; i < packets.size() / 2; i++)
   {
-    auto comparison = compare_packets(packets[i * 2], packets[i * 2 + 1]);
+    auto comparison = compare_packets_fast(packets[i * 2], packets[i * 2 + 1]);
     packet_pair_status[i] = comparison == GREATER ? false : true;
     // std::cout << packets[i * 2] << " vs. " << packets[i * 2 + 1] << ": " << (packet_pair_status[i] ? "true" : "false") << std::endl;
   }
@@ -0,0 +1,123 @@
+//-------------------------------------------------------------------------------------------------
+// Day 13: Distress Signal (differential check)
+// by Rene Jotham C. Culaway
+//
+// Runs the original `compare_packets` and `compare_packets_fast` on the same randomly generated
+// packet pairs, checks that they always agree, and reports how much faster the new one is.
+//-------------------------------------------------------------------------------------------------
+
+#include "day13.hpp"
+#include "../utils/differential.hpp"
+
+const size_t DEFAULT_NUM_CASES = 100000;
+const int MAX_DEPTH = 4;
+const int MAX_LIST_LENGTH = 5;
+const int MAX_VALUE = 10;
+
+using packet_pair = std::pair<packet, packet>;
+
+/// @brief Generates a random (sub)packet.
+/// @param rng The random number generator.
+/// @param depth How deep the subpacket is nested.
+/// @return The subpacket.
+packet generate_packet(std::mt19937_64 &rng, int depth = 0)
+{
+  // The top level is always a list.
+  if (depth > 0 && (depth >= MAX_DEPTH || rng() % 2 == 0))
+  {
+    return std::to_string(rng() % (MAX_VALUE + 1));
+  }
+
+  packet list = "[";
+  int length = rng() % (MAX_LIST_LENGTH + 1);
+  for (int i = 0; i < length; i++)
+  {
+    if (i > 0)
+      list += ",";
+    list += generate_packet(rng, depth + 1);
+  }
+  return list + "]";
+}
+
+/// @brief Lists the (string) spans of every element at every depth of a packet.
+/// @param pckt The packet.
+/// @return The start and end indices of each element.
+std::vector<std::pair<size_t, size_t>> enumerate_elements(const packet &pckt)
+{
+  std::vector<std::pair<size_t, size_t>> elements;
+  std::vector<size_t> list_starts;
+  for (size_t i = 0; i < pckt.size(); i++)
+  {
+    if (pckt[i] == '[')
+    {
+      list_starts.emplace_back(i);
+    }
+    else if (pckt[i] == ']')
+    {
+      if (list_starts.back() > 0) // The outermost list is not removable.
+        elements.emplace_back(list_starts.back(), i + 1);
+      list_starts.pop_back();
+    }
+    else if (std::isdigit(pckt[i]) && !std::isdigit(pckt[i - 1]))
+    {
+      size_t end = i;
+      while (std::isdigit(pckt[end]))
+        end++;
+      elements.emplace_back(i, end);
+    }
+  }
+  return elements;
+}
+
+/// @brief Produces smaller variants of a packet by removing one element, or by replacing a list with its contents.
+/// @param pckt The packet.
+/// @return The variants.
+std::vector<packet> shrink_packet(const packet &pckt)
+{
+  std::vector<packet> variants;
+  for (auto &[start, end] : enumerate_elements(pckt))
+  {
+    // Remove the element along with one of its separating commas.
+    size_t erase_start = start, erase_end = end;
+    if (pckt[erase_end] == ',')
+      erase_end++;
+    else if (pckt[erase_start - 1] == ',')
+      erase_start--;
+    variants.emplace_back(pckt.substr(0, erase_start) + pckt.substr(erase_end));
+
+    // Unwrap a non-empty list.
+    if (pckt[start] == '[' && end - start > 2)
+    {
+      variants.emplace_back(pckt.substr(0, start) + pckt.substr(start + 1, end - start - 2) + pckt.substr(end));
+    }
+  }
+  return variants;
+}
+
+int main(int argc, char *argv[])
+{
+  size_t num_cases = argc > 1 ? std::stoull(argv[1]) : DEFAULT_NUM_CASES;
+
+  auto report = utils::run_differential(
+      "compare_packets", num_cases,
+      [](std::mt19937_64 &rng)
+      { return packet_pair(generate_packet(rng), generate_packet(rng)); },
+      [](const packet_pair &pair)
+      { return compare_packets(pair.first, pair.second); },
+      [](const packet_pair &pair)
+      { return compare_packets_fast(pair.first, pair.second); },
+      [](const packet_pair &pair)
+      {
+        std::vector<packet_pair> variants;
+        for (auto &left : shrink_packet(pair.first))
+          variants.emplace_back(left, pair.second);
+        for (auto &right : shrink_packet(pair.second))
+          variants.emplace_back(pair.first, right);
+        return variants;
+      },
+      [](std::ostream &out, const packet_pair &pair)
+      { out << pair.first << "\n"
+            << pair.second << "\n"; });
+
+  return report.num_mismatches == 0 ? 0 : 1;
+}
@@ -0,0 +1,32 @@
+#pragma once
+#include <algorithm>
+#include <chrono>
+#include <iostream>
+#include <string>
+
+namespace utils
+{
+  /// @brief Runs a step a few times and reports its best throughput, e.g. "SIMD scan:	3.2 GB/s".
+  /// @param name The name of the step, for the report.
+  /// @param num_bytes The size of the input one run covers.
+  /// @param repetitions The number of runs. At least one run is made.
+  /// @param run Called as `run()`. Its result must be default-constructible.
+  /// @param out Where to write the report.
+  /// @return The result of the last run.
+  template <class Run>
+  auto report_throughput(const std::string &name, size_t num_bytes, size_t repetitions, Run run, std::ostream &out = std::cout)
+  {
+    decltype(run()) result{};
+    double best_seconds = 0;
+    for (size_t i = 0; i < std::max<size_t>(1, repetitions); i++)
+    {
+      auto start = std::chrono::steady_clock::now();
+      result = run();
+      double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+      best_seconds = i == 0 ? seconds : std::min(best_seconds, seconds);
+    }
+    double gigabytes_per_second = best_seconds > 0 ? num_bytes / best_seconds / 1e9 : 0;
+    out << name << ":\t" << gigabytes_per_second << " GB/s\n";
+    return result;
+  }
+}
@@ -0,0 +1,243 @@
+#pragma once
+#include "parallel.hpp"
+#include <cstdint>
+#include <cstring>
+#include <chrono>
+#include <iostream>
+#include <type_traits>
+#include <utility>
+
+#ifdef __linux__
+#include <sys/mman.h>
+#endif
+
+namespace utils
+{
+  /// @brief How the pages behind a LargeBuffer are obtained.
+  enum class PagePolicy
+  {
+    PLAIN,                  // Plain `new`.
+    TRANSPARENT_HUGE_PAGES, // Anonymous mapping aligned to 2 MiB and advised with `MADV_HUGEPAGE`.
+    HUGETLBFS               // Explicit huge pages from the hugetlbfs pool (`MAP_HUGETLB`). Falls back to transparent huge pages if the pool is empty.
+  };
+
+  const size_t HUGE_PAGE_SIZE = 2 << 20;
+  const size_t HUGE_PAGE_THRESHOLD = 32 << 20; // Buffers at least this large default to huge pages.
+
+  /// @brief Chooses the page policy for a buffer of a given size. Huge pages only pay off for buffers large enough to thrash the TLB.
+  /// @param bytes The size of the buffer.
+  /// @return `TRANSPARENT_HUGE_PAGES` for large buffers on Linux, `PLAIN` otherwise.
+  PagePolicy default_page_policy(size_t bytes)
+  {
+#ifdef __linux__
+    return bytes >= HUGE_PAGE_THRESHOLD ? PagePolicy::TRANSPARENT_HUGE_PAGES : PagePolicy::PLAIN;
+#else
+    return PagePolicy::PLAIN;
+#endif
+  }
+
+  const char *page_policy_to_string(PagePolicy policy)
+  {
+    switch (policy)
+    {
+    case PagePolicy::TRANSPARENT_HUGE_PAGES:
+      return "transparent huge pages";
+    case PagePolicy::HUGETLBFS:
+      return "hugetlbfs";
+    default:
+      return "plain new";
+    }
+  }
+
+  /// @brief A fixed-size array for large grids and fields, optionally backed by huge pages.
+  /// The elements are zero-initialized by `parallel_for` so that, on NUMA machines, each page is first touched (and therefore placed)
+  /// by the thread that processes that slice when the same `parallel_for` slicing is used afterwards.
+  template <class T>
+  class LargeBuffer
+  {
+    static_assert(std::is_trivially_copyable<T>::value && std::is_trivially_destructible<T>::value,
+                  "LargeBuffer only holds trivial types, since its pages are zero-filled and never destructed.");
+
+  private:
+    T *data = nullptr;
+    size_t count = 0;
+    size_t mapped_bytes = 0; // Non-zero if the memory came from `mmap` rather than `new`.
+    PagePolicy policy = PagePolicy::PLAIN;
+
+    /// @brief Tries to map `bytes` (rounded up to whole huge pages) with the given policy.
+    /// @return `true` if the mapping succeeded.
+    bool map_pages(size_t bytes, PagePolicy requested_policy)
+    {
+#ifdef __linux__
+      size_t rounded_bytes = (bytes + HUGE_PAGE_SIZE - 1) / HUGE_PAGE_SIZE * HUGE_PAGE_SIZE;
+      if (requested_policy == PagePolicy::HUGETLBFS)
+      {
+        void *mapping = mmap(nullptr, rounded_bytes, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS | MAP_HUGETLB, -1, 0);
+        if (mapping != MAP_FAILED)
+        {
+          data = (T *)mapping;
+          mapped_bytes = rounded_bytes;
+          policy = PagePolicy::HUGETLBFS;
+          return true;
+        }
+      }
+
+      // Over-allocate by one huge page so that the usable region can start on a 2 MiB boundary, which transparent huge pages require.
+      size_t padded_bytes = rounded_bytes + HUGE_PAGE_SIZE;
+      void *mapping = mmap(nullptr, padded_bytes, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+      if (mapping == MAP_FAILED)
+      {
+        return false;
+      }
+      uintptr_t start = (uintptr_t)mapping;
+      uintptr_t aligned_start = (start + HUGE_PAGE_SIZE - 1) / HUGE_PAGE_SIZE * HUGE_PAGE_SIZE;
+      if (aligned_start > start)
+      {
+        munmap(mapping, aligned_start - start);
+      }
+      uintptr_t aligned_end = aligned_start + rounded_bytes;
+      if (start + padded_bytes > aligned_end)
+      {
+        munmap((void *)aligned_end, start + padded_bytes - aligned_end);
+      }
+      madvise((void *)aligned_start, rounded_bytes, MADV_HUGEPAGE);
+
+      data = (T *)aligned_start;
+      mapped_bytes = rounded_bytes;
+      policy = PagePolicy::TRANSPARENT_HUGE_PAGES;
+      return true;
+#else
+      return false;
+#endif
+    }
+
+    void release()
+    {
+#ifdef __linux__
+      if (mapped_bytes > 0)
+      {
+        munmap(data, mapped_bytes);
+      }
+      else
+#endif
+      {
+        delete[] (unsigned char *)data;
+      }
+      data = nullptr;
+      count = 0;
+      mapped_bytes = 0;
+    }
+
+  public:
+    /// @brief Allocates and zero-fills a buffer.
+    /// @param count The number of elements.
+    /// @param requested_policy How to obtain the pages. Silently falls back to `PLAIN` where huge pages are unavailable.
+    /// @param num_threads The number of threads that will work on the buffer, and therefore first-touch it. Use 1 for single-threaded code.
+    LargeBuffer(size_t count, PagePolicy requested_policy, size_t num_threads = get_thread_count()) : count(count)
+    {
+      size_t bytes = count * sizeof(T);
+      if (requested_policy == PagePolicy::PLAIN || !map_pages(bytes, requested_policy))
+      {
+        data = (T *)new unsigned char[bytes > 0 ? bytes : 1];
+        policy = PagePolicy::PLAIN;
+      }
+
+      parallel_for(count, [&](size_t begin, size_t end, size_t)
+                   { std::memset((void *)(data + begin), 0, (end - begin) * sizeof(T)); },
+                   num_threads);
+    }
+
+    LargeBuffer(size_t count = 0) : LargeBuffer(count, default_page_policy(count * sizeof(T)))
+    {
+    }
+
+    LargeBuffer(const LargeBuffer &) = delete;
+    LargeBuffer &operator=(const LargeBuffer &) = delete;
+
+    LargeBuffer(LargeBuffer &&other) noexcept
+        : data(std::exchange(other.data, nullptr)), count(std::exchange(other.count, 0)),
+          mapped_bytes(std::exchange(other.mapped_bytes, 0)), policy(other.policy)
+    {
+    }
+
+    LargeBuffer &operator=(LargeBuffer &&other) noexcept
+    {
+      if (this != &other)
+      {
+        release();
+        data = std::exchange(other.data, nullptr);
+        count = std::exchange(other.count, 0);
+        mapped_bytes = std::exchange(other.mapped_bytes, 0);
+        policy = other.policy;
+      }
+      return *this;
+    }
+
+    ~LargeBuffer()
+    {
+      release();
+    }
+
+    T &operator[](size_t i)
+    {
+      return data[i];
+    }
+
+    const T &operator[](size_t i) const
+    {
+      return data[i];
+    }
+
+    T *begin()
+    {
+      return data;
+    }
+
+    T *end()
+    {
+      return data + count;
+    }
+
+    size_t size() const
+    {
+      return count;
+    }
+
+    /// @brief Gets the policy that was actually used, which may differ from the requested one after a fallback.
+    PagePolicy get_policy() const
+    {
+      return policy;
+    }
+  };
+
+  /// @brief Compares the page policies on a buffer of the given size. For each policy, times the allocation (including the
+  /// parallel first touch) and a pseudo-random gather over the buffer, which is dominated by TLB misses on large buffers.
+  /// @param bytes The size of the buffer to test.
+  /// @param out Where to print the results.
+  void benchmark_page_policies(size_t bytes, std::ostream &out = std::cout)
+  {
+    const PagePolicy policies[] = {PagePolicy::PLAIN, PagePolicy::TRANSPARENT_HUGE_PAGES, PagePolicy::HUGETLBFS};
+    size_t count = bytes / sizeof(uint32_t);
+    const size_t num_accesses = 1 << 24;
+
+    for (PagePolicy requested_policy : policies)
+    {
+      auto start = std::chrono::steady_clock::now();
+      LargeBuffer<uint32_t> buffer(count, requested_policy);
+      auto allocated = std::chrono::steady_clock::now();
+
+      uint64_t state = 0x9E3779B97F4A7C15ULL, checksum = 0;
+      for (size_t i = 0; i < num_accesses && count > 0; i++)
+      {
+        state = state * 6364136223846793005ULL + 1442695040888963407ULL; // LCG, so that the accesses defeat the prefetcher.
+        checksum += buffer[(state >> 33) % count]++;
+      }
+      auto accessed = std::chrono::steady_clock::now();
+
+      out << page_policy_to_string(requested_policy) << " (got " << page_policy_to_string(buffer.get_policy()) << "):\t"
+          << "allocate " << std::chrono::duration<double, std::milli>(allocated - start).count() << " ms,\t"
+          << "random access " << std::chrono::duration<double, std::milli>(accessed - allocated).count() << " ms"
+          << " (checksum " << checksum << ")\n";
+    }
+  }
+}
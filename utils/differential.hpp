@@ -0,0 +1,133 @@
+#pragma once
+#include <chrono>
+#include <cstdint>
+#include <iostream>
+#include <optional>
+#include <random>
+#include <string>
+#include <vector>
+
+namespace utils
+{
+  /// @brief The outcome of a differential run.
+  template <class Input>
+  struct DifferentialReport
+  {
+    size_t num_cases = 0;
+    size_t num_mismatches = 0;
+    double reference_seconds = 0;
+    double optimized_seconds = 0;
+    std::optional<Input> minimized_failure; // The smallest failing input found, if any case failed.
+
+    double get_speedup() const
+    {
+      return optimized_seconds > 0 ? reference_seconds / optimized_seconds : 0;
+    }
+  };
+
+  /// @brief Greedily shrinks a failing input. Each round asks `shrink` for smaller variants and keeps the first one that still fails,
+  /// until no variant fails anymore.
+  /// @param input The failing input.
+  /// @param is_failing Checks if an input still fails, called as `is_failing(const Input &)`.
+  /// @param shrink Produces smaller variants of an input, called as `shrink(const Input &)` and returning a `std::vector<Input>`.
+  /// @return A locally minimal failing input.
+  template <class Input, class IsFailing, class Shrink>
+  Input minimize_failure(Input input, IsFailing is_failing, Shrink shrink)
+  {
+    bool has_shrunk = true;
+    while (has_shrunk)
+    {
+      has_shrunk = false;
+      for (Input &candidate : shrink(input))
+      {
+        if (is_failing(candidate))
+        {
+          input = std::move(candidate);
+          has_shrunk = true;
+          break;
+        }
+      }
+    }
+    return input;
+  }
+
+  /// @brief Runs a reference solver (the original, trusted implementation) and an optimized solver on the same generated inputs,
+  /// checks that their answers are identical, and reports the speedup. The first mismatching input is shrunk and printed.
+  /// @param name The name of the pair of solvers, for the report.
+  /// @param num_cases The number of inputs to generate.
+  /// @param generate Creates an input, called as `generate(std::mt19937_64 &)`.
+  /// @param reference The reference solver, called as `reference(const Input &)`.
+  /// @param optimized The optimized solver. Must return the same type as `reference`.
+  /// @param shrink Produces smaller variants of an input (see `minimize_failure`).
+  /// @param print Writes an input, called as `print(std::ostream &, const Input &)`.
+  /// @param out Where to write the report.
+  /// @param seed The random seed, so that failures can be reproduced.
+  /// @return The report.
+  template <class Generate, class Reference, class Optimized, class Shrink, class Print>
+  auto run_differential(const std::string &name, size_t num_cases, Generate generate, Reference reference, Optimized optimized,
+                        Shrink shrink, Print print, std::ostream &out = std::cout, uint64_t seed = 2022)
+  {
+    std::mt19937_64 rng(seed);
+    using Input = decltype(generate(rng));
+    using Answer = decltype(reference(std::declval<const Input &>()));
+
+    DifferentialReport<Input> report;
+    report.num_cases = num_cases;
+
+    std::vector<Input> inputs;
+    inputs.reserve(num_cases);
+    for (size_t i = 0; i < num_cases; i++)
+    {
+      inputs.emplace_back(generate(rng));
+    }
+
+    // Each solver runs over the whole batch on its own, so that their timings do not interfere with each other.
+    std::vector<Answer> reference_answers, optimized_answers;
+    reference_answers.reserve(num_cases);
+    optimized_answers.reserve(num_cases);
+
+    auto start = std::chrono::steady_clock::now();
+    for (const Input &input : inputs)
+    {
+      reference_answers.emplace_back(reference(input));
+    }
+    auto reference_end = std::chrono::steady_clock::now();
+    for (const Input &input : inputs)
+    {
+      optimized_answers.emplace_back(optimized(input));
+    }
+    auto optimized_end = std::chrono::steady_clock::now();
+
+    report.reference_seconds = std::chrono::duration<double>(reference_end - start).count();
+    report.optimized_seconds = std::chrono::duration<double>(optimized_end - reference_end).count();
+
+    for (size_t i = 0; i < num_cases; i++)
+    {
+      if (reference_answers[i] == optimized_answers[i])
+      {
+        continue;
+      }
+
+      report.num_mismatches++;
+      if (!report.minimized_failure.has_value())
+      {
+        auto is_failing = [&](const Input &input)
+        { return !(reference(input) == optimized(input)); };
+        report.minimized_failure = minimize_failure(inputs[i], is_failing, shrink);
+      }
+    }
+
+    out << name << ": " << num_cases - report.num_mismatches << "/" << num_cases << " identical, "
+        << "reference " << report.reference_seconds << " s, optimized " << report.optimized_seconds << " s, "
+        << "speedup " << report.get_speedup() << "x\n";
+
+    if (report.minimized_failure.has_value())
+    {
+      out << "Minimized failing input:\n";
+      print(out, *report.minimized_failure);
+      out << "\n";
+    }
+
+    return report;
+  }
+}
@@ -0,0 +1,63 @@
+//-------------------------------------------------------------------------------------------------
+// Input embedder
+// by Rene Jotham C. Culaway
+//
+// Turns an input file into a header defining `EMBEDDED_INPUT`, a `constexpr std::string_view`
+// over the file's bytes, so that the `dayXX_embedded.cpp` drivers can solve it at compile time.
+//
+// Usage: embed_input input.txt input.embedded.hpp
+//
+// Large inputs may need a higher constant-evaluation budget, e.g. `-fconstexpr-ops-limit=` and
+// `-fconstexpr-loop-limit=` on GCC, `-fconstexpr-steps=` on Clang, or `/constexpr:steps` on MSVC.
+//-------------------------------------------------------------------------------------------------
+
+#include <iostream>
+#include <fstream>
+#include <iterator>
+#include <string>
+#include <vector>
+
+const size_t BYTES_PER_LINE = 16;
+const char HEX_DIGITS[] = "0123456789abcdef";
+
+int main(int argc, char *argv[])
+{
+  if (argc < 3)
+  {
+    std::cout << "Usage: " << argv[0] << " <input file> <output header>\n";
+    return 1;
+  }
+
+  std::ifstream input_file_handle(argv[1], std::ios::binary);
+  if (!input_file_handle.is_open())
+  {
+    std::cout << "Failed to read " << argv[1] << ".\n";
+    return 1;
+  }
+  std::vector<char> bytes((std::istreambuf_iterator<char>(input_file_handle)), std::istreambuf_iterator<char>());
+
+  std::ofstream output_file_handle(argv[2]);
+  if (!output_file_handle.is_open())
+  {
+    std::cout << "Failed to write " << argv[2] << ".\n";
+    return 1;
+  }
+
+  // A byte array rather than a string literal, since string literals have length limits on some compilers.
+  output_file_handle << "// Generated by embed_input from " << argv[1] << ". Do not edit.\n"
+                     << "#pragma once\n"
+                     << "#include <string_view>\n\n"
+                     << "constexpr char EMBEDDED_INPUT_BYTES[] = {";
+  for (size_t i = 0; i < bytes.size(); i++)
+  {
+    if (i % BYTES_PER_LINE == 0)
+    {
+      output_file_handle << "\n   ";
+    }
+    output_file_handle << " '\\x" << HEX_DIGITS[(unsigned char)bytes[i] >> 4] << HEX_DIGITS[(unsigned char)bytes[i] & 0xF] << "',";
+  }
+  output_file_handle << "\n    '\\0'};\n\n"
+                     << "constexpr std::string_view EMBEDDED_INPUT(EMBEDDED_INPUT_BYTES, " << bytes.size() << ");\n";
+
+  return 0;
+}
@@ -0,0 +1,229 @@
+#pragma once
+#include <vector>
+#include <stdexcept>
+#include <utility>
+
+namespace utils
+{
+  const size_t NOT_IN_QUEUE = (size_t)-1;
+
+  /// @brief A binary min-heap over dense integer ids `0..capacity - 1`. Each id is in the heap at most once, and its priority can be
+  /// lowered in place (decrease-key) in O(log n), so searches never need to push duplicates.
+  /// This is zero-indexed, unlike `Heap`.
+  template <class Priority>
+  class IndexedMinHeap
+  {
+  private:
+    std::vector<size_t> heap;         // The ids, in heap order.
+    std::vector<size_t> positions;    // Where each id is in `heap`, or `NOT_IN_QUEUE`.
+    std::vector<Priority> priorities; // The priority of each id.
+
+    bool is_less(size_t i, size_t j)
+    {
+      return priorities[heap[i]] < priorities[heap[j]];
+    }
+
+    void swap(size_t i, size_t j)
+    {
+      std::swap(heap[i], heap[j]);
+      positions[heap[i]] = i;
+      positions[heap[j]] = j;
+    }
+
+    void percolate_up(size_t i)
+    {
+      while (i > 0)
+      {
+        size_t parent_index = (i - 1) / 2;
+        if (!is_less(i, parent_index))
+        {
+          break;
+        }
+        swap(i, parent_index);
+        i = parent_index;
+      }
+    }
+
+    void percolate_down(size_t i)
+    {
+      while (true)
+      {
+        size_t left_child_index = 2 * i + 1;
+        size_t right_child_index = 2 * i + 2;
+        size_t smallest_index = i;
+        if (left_child_index < heap.size() && is_less(left_child_index, smallest_index))
+        {
+          smallest_index = left_child_index;
+        }
+        if (right_child_index < heap.size() && is_less(right_child_index, smallest_index))
+        {
+          smallest_index = right_child_index;
+        }
+        if (smallest_index == i)
+        {
+          break;
+        }
+        swap(i, smallest_index);
+        i = smallest_index;
+      }
+    }
+
+  public:
+    IndexedMinHeap(size_t capacity) : positions(capacity, NOT_IN_QUEUE), priorities(capacity)
+    {
+    }
+
+    bool is_empty() const
+    {
+      return heap.empty();
+    }
+
+    bool contains(size_t id) const
+    {
+      return positions[id] != NOT_IN_QUEUE;
+    }
+
+    /// @brief Inserts an id, or lowers its priority if it is already queued with a higher one.
+    /// @param id The id.
+    /// @param priority The new priority.
+    /// @return `true` if the id was inserted or its priority lowered.
+    bool push_or_decrease(size_t id, Priority priority)
+    {
+      if (contains(id))
+      {
+        if (!(priority < priorities[id]))
+        {
+          return false;
+        }
+        priorities[id] = priority;
+        percolate_up(positions[id]);
+        return true;
+      }
+
+      priorities[id] = priority;
+      positions[id] = heap.size();
+      heap.emplace_back(id);
+      percolate_up(heap.size() - 1);
+      return true;
+    }
+
+    /// @brief Removes the id with the lowest priority.
+    /// @return The id.
+    size_t pop()
+    {
+      if (is_empty())
+      {
+        throw std::underflow_error("Heap is empty.");
+      }
+      size_t min_id = heap[0];
+      swap(0, heap.size() - 1);
+      heap.pop_back();
+      positions[min_id] = NOT_IN_QUEUE;
+      if (!is_empty())
+      {
+        percolate_down(0);
+      }
+      return min_id;
+    }
+  };
+
+  /// @brief A monotone bucket queue (Dial's algorithm) over dense integer ids, for small non-negative integer priorities.
+  /// Push, decrease-key and removal are O(1), and pop is amortized O(1), as long as every queued priority stays within
+  /// `bucket_count - 1` of the last popped one and never goes below it (which holds for Dijkstra, and for A* with a consistent
+  /// heuristic, when `bucket_count` exceeds the largest change in priority along an edge).
+  class BucketQueue
+  {
+  private:
+    std::vector<std::vector<size_t>> buckets; // Circular; priority p lives in bucket p % bucket_count.
+    std::vector<size_t> positions;            // Where each id is within its bucket, or `NOT_IN_QUEUE`.
+    std::vector<unsigned int> priorities;
+    unsigned int current_priority = 0; // No queued priority is below this.
+    bool is_started = false;
+    size_t size = 0;
+
+    std::vector<size_t> &get_bucket(unsigned int priority)
+    {
+      return buckets[priority % buckets.size()];
+    }
+
+    /// @brief Removes an id from its bucket by swapping it with the last one.
+    void remove(size_t id)
+    {
+      std::vector<size_t> &bucket = get_bucket(priorities[id]);
+      size_t position = positions[id];
+      bucket[position] = bucket.back();
+      positions[bucket[position]] = position;
+      bucket.pop_back();
+      positions[id] = NOT_IN_QUEUE;
+      size--;
+    }
+
+  public:
+    BucketQueue(size_t capacity, size_t bucket_count) : buckets(bucket_count), positions(capacity, NOT_IN_QUEUE), priorities(capacity)
+    {
+      if (bucket_count == 0)
+      {
+        throw std::invalid_argument("There must be at least one bucket.");
+      }
+    }
+
+    bool is_empty() const
+    {
+      return size == 0;
+    }
+
+    bool contains(size_t id) const
+    {
+      return positions[id] != NOT_IN_QUEUE;
+    }
+
+    /// @brief Inserts an id, or lowers its priority if it is already queued with a higher one.
+    /// @param id The id.
+    /// @param priority The new priority.
+    /// @return `true` if the id was inserted or its priority lowered.
+    bool push_or_decrease(size_t id, unsigned int priority)
+    {
+      if (!is_started)
+      {
+        current_priority = priority; // The window starts wherever the first priority is.
+        is_started = true;
+      }
+      if (priority < current_priority || priority - current_priority >= buckets.size())
+      {
+        throw std::out_of_range("Priority is outside of the bucket window.");
+      }
+      if (contains(id))
+      {
+        if (priority >= priorities[id])
+        {
+          return false;
+        }
+        remove(id);
+      }
+
+      priorities[id] = priority;
+      std::vector<size_t> &bucket = get_bucket(priority);
+      positions[id] = bucket.size();
+      bucket.emplace_back(id);
+      size++;
+      return true;
+    }
+
+    /// @brief Removes an id with the lowest priority.
+    /// @return The id.
+    size_t pop()
+    {
+      if (is_empty())
+      {
+        throw std::underflow_error("Queue is empty.");
+      }
+      while (get_bucket(current_priority).empty())
+      {
+        current_priority++;
+      }
+      size_t min_id = get_bucket(current_priority).back();
+      remove(min_id);
+      return min_id;
+    }
+  };
+}
@@ -0,0 +1,134 @@
+#pragma once
+#include <string>
+#include <string_view>
+#include <stdexcept>
+
+#ifdef _WIN32
+#define NOMINMAX
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace utils
+{
+  /// @brief A read-only memory mapping of a whole file. The contents can be read directly without copying them into strings first.
+  class MappedFile
+  {
+  private:
+    const char *data = nullptr;
+    size_t size = 0;
+
+#ifdef _WIN32
+    HANDLE file_handle = INVALID_HANDLE_VALUE;
+    HANDLE mapping_handle = nullptr;
+#else
+    int file_descriptor = -1;
+#endif
+
+    void unmap()
+    {
+#ifdef _WIN32
+      if (data)
+        UnmapViewOfFile(data);
+      if (mapping_handle)
+        CloseHandle(mapping_handle);
+      if (file_handle != INVALID_HANDLE_VALUE)
+        CloseHandle(file_handle);
+      mapping_handle = nullptr;
+      file_handle = INVALID_HANDLE_VALUE;
+#else
+      if (data)
+        munmap(const_cast<char *>(data), size);
+      if (file_descriptor >= 0)
+        close(file_descriptor);
+      file_descriptor = -1;
+#endif
+      data = nullptr;
+      size = 0;
+    }
+
+  public:
+    /// @brief Maps a file into memory.
+    /// @param file_name The file to map.
+    MappedFile(const std::string &file_name)
+    {
+#ifdef _WIN32
+      file_handle = CreateFileA(file_name.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+      if (file_handle == INVALID_HANDLE_VALUE)
+      {
+        throw std::runtime_error("Failed to open " + file_name + ".");
+      }
+
+      LARGE_INTEGER file_size;
+      if (!GetFileSizeEx(file_handle, &file_size))
+      {
+        unmap();
+        throw std::runtime_error("Failed to get the size of " + file_name + ".");
+      }
+      size = (size_t)file_size.QuadPart;
+      if (size == 0)
+      {
+        return; // Empty files cannot be mapped.
+      }
+
+      mapping_handle = CreateFileMappingA(file_handle, nullptr, PAGE_READONLY, 0, 0, nullptr);
+      data = mapping_handle ? (const char *)MapViewOfFile(mapping_handle, FILE_MAP_READ, 0, 0, 0) : nullptr;
+#else
+      file_descriptor = open(file_name.c_str(), O_RDONLY);
+      if (file_descriptor < 0)
+      {
+        throw std::runtime_error("Failed to open " + file_name + ".");
+      }
+
+      struct stat file_stat;
+      if (fstat(file_descriptor, &file_stat) != 0)
+      {
+        unmap();
+        throw std::runtime_error("Failed to get the size of " + file_name + ".");
+      }
+      size = (size_t)file_stat.st_size;
+      if (size == 0)
+      {
+        return; // Empty files cannot be mapped.
+      }
+
+      void *mapping = mmap(nullptr, size, PROT_READ, MAP_PRIVATE, file_descriptor, 0);
+      data = mapping == MAP_FAILED ? nullptr : (const char *)mapping;
+      if (data)
+      {
+        madvise(mapping, size, MADV_SEQUENTIAL);
+      }
+#endif
+      if (!data)
+      {
+        size = 0;
+        unmap();
+        throw std::runtime_error("Failed to map " + file_name + ".");
+      }
+    }
+
+    MappedFile(const MappedFile &) = delete;
+    MappedFile &operator=(const MappedFile &) = delete;
+
+    ~MappedFile()
+    {
+      unmap();
+    }
+
+    /// @brief Gets the contents of the file.
+    /// @return A view over the whole file.
+    std::string_view view() const
+    {
+      return std::string_view(data, size);
+    }
+
+    size_t get_size() const
+    {
+      return size;
+    }
+  };
+}
@@ -0,0 +1,61 @@
+#pragma once
+#include <thread>
+#include <vector>
+#include <exception>
+#include <algorithm>
+
+namespace utils
+{
+  /// @brief Gets the number of worker threads to use, which is the number of hardware threads (at least 1).
+  /// @return The number of worker threads.
+  size_t get_thread_count()
+  {
+    return std::max(1u, std::thread::hardware_concurrency());
+  }
+
+  /// @brief Splits `[0, count)` into contiguous, evenly-sized slices and processes each slice on its own thread.
+  /// The calling thread handles the first slice. Exceptions thrown by any slice are rethrown once every thread has finished.
+  /// @param count The number of items to process.
+  /// @param body Called as `body(begin, end, thread_idx)` for each slice.
+  /// @param num_threads The number of slices (and threads). Defaults to `get_thread_count()`.
+  template <class Body>
+  void parallel_for(size_t count, Body body, size_t num_threads = get_thread_count())
+  {
+    num_threads = std::max<size_t>(1, std::min(num_threads, count));
+    std::vector<std::thread> threads;
+    std::vector<std::exception_ptr> exceptions(num_threads);
+
+    auto run_slice = [&](size_t thread_idx)
+    {
+      size_t begin = count * thread_idx / num_threads;
+      size_t end = count * (thread_idx + 1) / num_threads;
+      try
+      {
+        body(begin, end, thread_idx);
+      }
+      catch (...)
+      {
+        exceptions[thread_idx] = std::current_exception();
+      }
+    };
+
+    for (size_t i = 1; i < num_threads; i++)
+    {
+      threads.emplace_back(run_slice, i);
+    }
+    run_slice(0);
+
+    for (auto &thread : threads)
+    {
+      thread.join();
+    }
+
+    for (auto &exception : exceptions)
+    {
+      if (exception)
+      {
+        std::rethrow_exception(exception);
+      }
+    }
+  }
+}
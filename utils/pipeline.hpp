@@ -0,0 +1,321 @@
+#pragma once
+#include <coroutine>
+#include <exception>
+#include <stdexcept>
+#include <algorithm>
+#include <optional>
+#include <utility>
+#include <vector>
+#include <deque>
+#include <mutex>
+#include <condition_variable>
+#include <thread>
+#include <fstream>
+#include <string>
+
+namespace utils
+{
+  /// @brief A lazily-evaluated sequence of values produced by a coroutine using `co_yield`.
+  /// Values are only computed when the consumer asks for the next one, so nothing has to be loaded up front.
+  template <class T>
+  class Generator
+  {
+  public:
+    struct promise_type
+    {
+      std::optional<T> current_value;
+      std::exception_ptr exception;
+
+      Generator get_return_object()
+      {
+        return Generator(std::coroutine_handle<promise_type>::from_promise(*this));
+      }
+
+      std::suspend_always initial_suspend() noexcept
+      {
+        return {};
+      }
+
+      std::suspend_always final_suspend() noexcept
+      {
+        return {};
+      }
+
+      std::suspend_always yield_value(T value)
+      {
+        current_value = std::move(value);
+        return {};
+      }
+
+      void return_void()
+      {
+      }
+
+      void unhandled_exception()
+      {
+        exception = std::current_exception();
+      }
+    };
+
+    /// @brief Input iterator over the generated values, so that a Generator can be used in a range-based for loop.
+    class iterator
+    {
+      std::coroutine_handle<promise_type> handle;
+
+    public:
+      iterator(std::coroutine_handle<promise_type> handle = nullptr) : handle(handle)
+      {
+      }
+
+      iterator &operator++()
+      {
+        handle.resume();
+        if (handle.done())
+        {
+          if (handle.promise().exception)
+          {
+            std::rethrow_exception(handle.promise().exception);
+          }
+          handle = nullptr;
+        }
+        return *this;
+      }
+
+      T &operator*() const
+      {
+        return *handle.promise().current_value;
+      }
+
+      bool operator==(const iterator &other) const
+      {
+        return handle == other.handle;
+      }
+    };
+
+  private:
+    std::coroutine_handle<promise_type> handle;
+
+  public:
+    explicit Generator(std::coroutine_handle<promise_type> handle) : handle(handle)
+    {
+    }
+
+    Generator(const Generator &) = delete;
+    Generator &operator=(const Generator &) = delete;
+
+    Generator(Generator &&other) noexcept : handle(std::exchange(other.handle, nullptr))
+    {
+    }
+
+    Generator &operator=(Generator &&other) noexcept
+    {
+      if (this != &other)
+      {
+        if (handle)
+        {
+          handle.destroy();
+        }
+        handle = std::exchange(other.handle, nullptr);
+      }
+      return *this;
+    }
+
+    ~Generator()
+    {
+      if (handle)
+      {
+        handle.destroy();
+      }
+    }
+
+    /// @brief Runs the coroutine up to its first `co_yield`.
+    /// @return An iterator pointing to the first value, or `end()` if nothing was yielded.
+    iterator begin()
+    {
+      if (!handle)
+      {
+        return iterator();
+      }
+      return ++iterator(handle);
+    }
+
+    iterator end()
+    {
+      return iterator();
+    }
+  };
+
+  /// @brief A fixed-capacity, thread-safe FIFO queue. Pushing blocks while the queue is full and popping blocks while it is empty,
+  /// which keeps a fast producer from running arbitrarily far ahead of its consumers.
+  template <class T>
+  class BoundedQueue
+  {
+  private:
+    std::deque<T> queue;
+    size_t capacity;
+    bool closed = false;
+
+    std::mutex mutex;
+    std::condition_variable not_full;
+    std::condition_variable not_empty;
+
+  public:
+    BoundedQueue(size_t capacity) : capacity(capacity)
+    {
+      if (capacity <= 0)
+      {
+        throw std::invalid_argument("Queue capacity must be positive.");
+      }
+    }
+
+    /// @brief Enqueues a value, waiting for space if the queue is full.
+    /// @param value The value to enqueue.
+    void push(T value)
+    {
+      std::unique_lock<std::mutex> lock(mutex);
+      not_full.wait(lock, [&]()
+                    { return queue.size() < capacity || closed; });
+      if (closed)
+      {
+        throw std::logic_error("Cannot push to a closed queue.");
+      }
+      queue.emplace_back(std::move(value));
+      not_empty.notify_one();
+    }
+
+    /// @brief Dequeues a value, waiting for one if the queue is empty.
+    /// @return The front of the queue, or nothing if the queue is empty and has been closed.
+    std::optional<T> pop()
+    {
+      std::unique_lock<std::mutex> lock(mutex);
+      not_empty.wait(lock, [&]()
+                     { return !queue.empty() || closed; });
+      if (queue.empty())
+      {
+        return {};
+      }
+      T value = std::move(queue.front());
+      queue.pop_front();
+      not_full.notify_one();
+      return value;
+    }
+
+    /// @brief Signals that nothing else will be pushed. Waiting consumers drain the remaining values and then stop.
+    void close()
+    {
+      std::lock_guard<std::mutex> lock(mutex);
+      closed = true;
+      not_empty.notify_all();
+      not_full.notify_all();
+    }
+  };
+
+  /// @brief Streams the lines of a file one at a time.
+  /// @param file_name The file to read.
+  /// @return A generator of each line in the file.
+  Generator<std::string> lines_from_file(const std::string file_name)
+  {
+    std::ifstream file_handle(file_name);
+
+    if (!file_handle.is_open())
+    {
+      co_return;
+    }
+
+    std::string current_line;
+    while (std::getline(file_handle, current_line))
+    {
+      co_yield current_line;
+    }
+  }
+
+  /// @brief Runs a producer and its consumers concurrently. The producer is driven on the calling thread and its values are handed,
+  /// in batches, through a bounded queue to `num_workers` consumer threads. Each worker folds the values it receives into its own accumulator,
+  /// so at most `capacity` batches are ever held in memory regardless of the size of the input.
+  /// @param producer The generator of records, e.g. parsed lines.
+  /// @param initial The starting value of each worker's accumulator.
+  /// @param step Folds a record into an accumulator. Called as `step(Accumulator &, T &&)`.
+  /// @param num_workers The number of consumer threads. Use 1 if records must be consumed in order.
+  /// @param capacity The maximum number of batches waiting in the queue.
+  /// @param batch_size The number of records per batch.
+  /// @return One accumulator per worker, to be combined by the caller.
+  template <class T, class Accumulator, class Step>
+  std::vector<Accumulator> pipeline_reduce(Generator<T> producer, const Accumulator &initial, Step step,
+                                           size_t num_workers = std::max(2u, std::thread::hardware_concurrency()) - 1,
+                                           size_t capacity = 16, size_t batch_size = 1024)
+  {
+    BoundedQueue<std::vector<T>> batches(capacity);
+    std::vector<Accumulator> accumulators(num_workers, initial);
+    std::vector<std::exception_ptr> exceptions(num_workers);
+    std::vector<std::thread> workers;
+
+    for (size_t i = 0; i < num_workers; i++)
+    {
+      workers.emplace_back([&, i]()
+                           {
+                             while (auto batch = batches.pop())
+                             {
+                               if (exceptions[i])
+                               {
+                                 continue; // Keep draining so that the producer never blocks on a full queue.
+                               }
+                               try
+                               {
+                                 for (T &record : *batch)
+                                 {
+                                   step(accumulators[i], std::move(record));
+                                 }
+                               }
+                               catch (...)
+                               {
+                                 exceptions[i] = std::current_exception();
+                               }
+                             } });
+    }
+
+    std::exception_ptr producer_exception;
+    try
+    {
+      std::vector<T> batch;
+      batch.reserve(batch_size);
+      for (T &record : producer)
+      {
+        batch.emplace_back(std::move(record));
+        if (batch.size() >= batch_size)
+        {
+          batches.push(std::move(batch));
+          batch = std::vector<T>();
+          batch.reserve(batch_size);
+        }
+      }
+      if (!batch.empty())
+      {
+        batches.push(std::move(batch));
+      }
+    }
+    catch (...)
+    {
+      producer_exception = std::current_exception();
+    }
+
+    batches.close();
+    for (auto &worker : workers)
+    {
+      worker.join();
+    }
+
+    if (producer_exception)
+    {
+      std::rethrow_exception(producer_exception);
+    }
+    for (auto &exception : exceptions)
+    {
+      if (exception)
+      {
+        std::rethrow_exception(exception);
+      }
+    }
+
+    return accumulators;
+  }
+}
@@ -0,0 +1,202 @@
+#pragma once
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+namespace utils
+{
+  /// @brief A mergeable KLL quantile sketch. It answers rank and quantile queries over a stream of values in memory that grows
+  /// with `k` and only logarithmically with the length of the stream. Values are kept in a stack of compactors: when a level
+  /// fills up, it is sorted and every other value is promoted to the next level with twice the weight.
+  /// Each compaction at level `h` moves any rank by `+2^h`, `-2^h` or not at all, depending on a coin flip, so the sketch sums the
+  /// variances of those moves to bound its error.
+  template <class T>
+  class QuantileSketch
+  {
+    static constexpr size_t MIN_CAPACITY = 8; // Keeps the lowest levels from compacting on nearly every value.
+
+    size_t k;
+    std::vector<std::vector<T>> compactors; // compactors[h] holds values of weight 2^h.
+    size_t num_values = 0;                  // The number of values added (the total weight).
+    size_t num_kept = 0;                    // The number of values held across all levels.
+    size_t max_kept = 0;
+    double rank_error_variance = 0; // The variance of the rank error of any query, in weight units squared.
+    uint64_t random_state = 0x9E3779B97F4A7C15ull;
+
+    /// @return The most values level `h` may hold before it is compacted. Lower levels get geometrically less room.
+    constexpr size_t get_capacity(size_t h) const
+    {
+      size_t depth = compactors.size() - h - 1;
+      size_t capacity = k;
+      for (size_t i = 0; i < depth && capacity > MIN_CAPACITY; i++)
+      {
+        capacity = capacity * 2 / 3;
+      }
+      return std::max(capacity, MIN_CAPACITY);
+    }
+
+    constexpr void grow()
+    {
+      compactors.emplace_back();
+      max_kept = 0;
+      for (size_t h = 0; h < compactors.size(); h++)
+      {
+        max_kept += get_capacity(h);
+      }
+    }
+
+    /// @return A pseudo-random bit, which picks whether the odd or the even values of a level are promoted.
+    constexpr size_t next_coin()
+    {
+      random_state ^= random_state << 13;
+      random_state ^= random_state >> 7;
+      random_state ^= random_state << 17;
+      return random_state & 1;
+    }
+
+    /// @brief Compacts the lowest full levels until the sketch is back under its size limit.
+    constexpr void compress()
+    {
+      for (size_t h = 0; h < compactors.size(); h++)
+      {
+        if (compactors[h].size() < get_capacity(h))
+        {
+          continue;
+        }
+        if (h + 1 == compactors.size())
+        {
+          grow();
+        }
+
+        std::vector<T> &level = compactors[h];
+        std::sort(level.begin(), level.end());
+        size_t paired = level.size() & ~(size_t)1; // An odd value out stays behind.
+        for (size_t i = next_coin(); i < paired; i += 2)
+        {
+          compactors[h + 1].push_back(level[i]);
+        }
+        level.erase(level.begin(), level.begin() + paired);
+        num_kept -= paired / 2;
+        rank_error_variance += (double)((uint64_t)1 << h) * (double)((uint64_t)1 << h);
+
+        if (num_kept < max_kept)
+        {
+          break;
+        }
+      }
+    }
+
+  public:
+    /// @param k The size of the top level. Larger values give smaller errors; the rank error is roughly proportional to `1 / k`.
+    /// A size of 0 disables the sketch, so that it costs nothing when percentiles are not wanted.
+    constexpr QuantileSketch(size_t k = 0) : k(k)
+    {
+      if (k > 0)
+      {
+        grow();
+      }
+    }
+
+    constexpr size_t get_k() const
+    {
+      return k;
+    }
+
+    constexpr bool is_enabled() const
+    {
+      return k > 0;
+    }
+
+    constexpr size_t get_num_values() const
+    {
+      return num_values;
+    }
+
+    /// @return The number of values held, which bounds the sketch's memory.
+    constexpr size_t get_num_kept() const
+    {
+      return num_kept;
+    }
+
+    /// @return How far any rank answered by the sketch may be off, as a fraction of the number of values. This is three standard
+    /// deviations, so the error stays within it about 99.7% of the time.
+    double get_rank_error() const
+    {
+      return num_values > 0 ? 3 * std::sqrt(rank_error_variance) / num_values : 0;
+    }
+
+    constexpr void add(const T &value)
+    {
+      if (!is_enabled())
+      {
+        return;
+      }
+      compactors[0].push_back(value);
+      num_values++;
+      num_kept++;
+      if (num_kept >= max_kept)
+      {
+        compress();
+      }
+    }
+
+    /// @brief Adds every value seen by another sketch, e.g. one filled by another thread.
+    constexpr void merge(const QuantileSketch &other)
+    {
+      if (!is_enabled() || !other.is_enabled())
+      {
+        return;
+      }
+      while (compactors.size() < other.compactors.size())
+      {
+        grow();
+      }
+      for (size_t h = 0; h < other.compactors.size(); h++)
+      {
+        compactors[h].insert(compactors[h].end(), other.compactors[h].begin(), other.compactors[h].end());
+      }
+      num_values += other.num_values;
+      num_kept += other.num_kept;
+      rank_error_variance += other.rank_error_variance;
+      while (num_kept >= max_kept)
+      {
+        compress();
+      }
+    }
+
+    /// @brief Finds the value at a quantile.
+    /// @param quantile The quantile, from 0 to 1 (e.g. 0.99 for the 99th percentile).
+    /// @return The smallest kept value whose estimated rank reaches the quantile, or a default value if the sketch is empty.
+    constexpr T get_quantile(double quantile) const
+    {
+      std::vector<std::pair<T, uint64_t>> weighted;
+      weighted.reserve(num_kept);
+      for (size_t h = 0; h < compactors.size(); h++)
+      {
+        for (const T &value : compactors[h])
+        {
+          weighted.emplace_back(value, (uint64_t)1 << h);
+        }
+      }
+      if (weighted.empty())
+      {
+        return T{};
+      }
+      std::sort(weighted.begin(), weighted.end());
+
+      double target = quantile * num_values;
+      uint64_t cumulative_weight = 0;
+      for (const auto &[value, weight] : weighted)
+      {
+        cumulative_weight += weight;
+        if (cumulative_weight >= target)
+        {
+          return value;
+        }
+      }
+      return weighted.back().first;
+    }
+  };
+}
@@ -0,0 +1,320 @@
+#pragma once
+#include "mapped_file.hpp"
+#include "parallel.hpp"
+#include <cstdint>
+#include <cstring>
+#include <cctype>
+#include <chrono>
+#include <fstream>
+#include <sstream>
+#include <iomanip>
+#include <string>
+#include <string_view>
+#include <map>
+#include <tuple>
+#include <vector>
+
+/// The solver build id is part of every cache key, so rebuilding a solver invalidates its cached answers.
+/// Builds can pin it (e.g. to a commit hash) with `-DSOLVER_BUILD_ID=...`.
+#ifndef SOLVER_BUILD_ID
+#define SOLVER_BUILD_ID __DATE__ " " __TIME__
+#endif
+
+namespace utils
+{
+  namespace hash_detail
+  {
+    const uint64_t PRIME_1 = 0x9E3779B185EBCA87ULL;
+    const uint64_t PRIME_2 = 0xC2B2AE3D27D4EB4FULL;
+    const uint64_t PRIME_3 = 0x165667B19E3779F9ULL;
+    const uint64_t PRIME_4 = 0x85EBCA77C2B2AE63ULL;
+    const uint64_t PRIME_5 = 0x27D4EB2F165667C5ULL;
+
+    uint64_t rotate_left(uint64_t x, int bits)
+    {
+      return (x << bits) | (x >> (64 - bits));
+    }
+
+    uint64_t read_64(const char *bytes)
+    {
+      uint64_t value;
+      std::memcpy(&value, bytes, sizeof(value));
+      return value;
+    }
+
+    uint32_t read_32(const char *bytes)
+    {
+      uint32_t value;
+      std::memcpy(&value, bytes, sizeof(value));
+      return value;
+    }
+
+    uint64_t round(uint64_t accumulator, uint64_t input)
+    {
+      accumulator += input * PRIME_2;
+      accumulator = rotate_left(accumulator, 31);
+      return accumulator * PRIME_1;
+    }
+
+    uint64_t merge_round(uint64_t accumulator, uint64_t value)
+    {
+      accumulator ^= round(0, value);
+      return accumulator * PRIME_1 + PRIME_4;
+    }
+  }
+
+  /// @brief A fast, non-cryptographic 64-bit hash (the XXH64 algorithm). Processes 32 bytes per iteration in four independent lanes.
+  /// @param bytes The data to hash.
+  /// @param length The number of bytes.
+  /// @param seed The seed.
+  /// @return The hash of the data.
+  uint64_t hash_bytes(const char *bytes, size_t length, uint64_t seed = 0)
+  {
+    using namespace hash_detail;
+    const char *end = bytes + length;
+    uint64_t hash;
+
+    if (length >= 32)
+    {
+      uint64_t lanes[4] = {seed + PRIME_1 + PRIME_2, seed + PRIME_2, seed, seed - PRIME_1};
+      const char *limit = end - 32;
+      do
+      {
+        for (int i = 0; i < 4; i++)
+        {
+          lanes[i] = round(lanes[i], read_64(bytes + 8 * i));
+        }
+        bytes += 32;
+      } while (bytes <= limit);
+
+      hash = rotate_left(lanes[0], 1) + rotate_left(lanes[1], 7) + rotate_left(lanes[2], 12) + rotate_left(lanes[3], 18);
+      for (int i = 0; i < 4; i++)
+      {
+        hash = merge_round(hash, lanes[i]);
+      }
+    }
+    else
+    {
+      hash = seed + PRIME_5;
+    }
+
+    hash += (uint64_t)length;
+
+    for (; bytes + 8 <= end; bytes += 8)
+    {
+      hash ^= round(0, read_64(bytes));
+      hash = rotate_left(hash, 27) * PRIME_1 + PRIME_4;
+    }
+    if (bytes + 4 <= end)
+    {
+      hash ^= (uint64_t)read_32(bytes) * PRIME_1;
+      hash = rotate_left(hash, 23) * PRIME_2 + PRIME_3;
+      bytes += 4;
+    }
+    for (; bytes < end; bytes++)
+    {
+      hash ^= (uint64_t)(unsigned char)*bytes * PRIME_5;
+      hash = rotate_left(hash, 11) * PRIME_1;
+    }
+
+    hash ^= hash >> 33;
+    hash *= PRIME_2;
+    hash ^= hash >> 29;
+    hash *= PRIME_3;
+    hash ^= hash >> 32;
+    return hash;
+  }
+
+  /// @brief Hashes a large buffer in parallel. The buffer is cut into fixed-size blocks which are hashed concurrently,
+  /// then the block hashes are hashed together. Since the block size is fixed, the result does not depend on the number of threads.
+  /// @param contents The data to hash.
+  /// @param block_size The size of each independently-hashed block.
+  /// @return The hash of the data.
+  uint64_t hash_contents(std::string_view contents, size_t block_size = 1 << 20)
+  {
+    size_t num_blocks = (contents.size() + block_size - 1) / block_size;
+    if (num_blocks <= 1)
+    {
+      return hash_bytes(contents.data(), contents.size());
+    }
+
+    std::vector<uint64_t> block_hashes(num_blocks);
+    parallel_for(num_blocks, [&](size_t begin, size_t end, size_t)
+                 {
+                   for (size_t i = begin; i < end; i++)
+                   {
+                     std::string_view block = contents.substr(i * block_size, block_size);
+                     block_hashes[i] = hash_bytes(block.data(), block.size());
+                   }
+                 });
+
+    return hash_bytes((const char *)block_hashes.data(), block_hashes.size() * sizeof(uint64_t), contents.size());
+  }
+
+  /// @brief A previously computed answer.
+  struct CachedResult
+  {
+    std::string answer;
+    long long nanoseconds = 0; // How long the solver took when the answer was first computed.
+    bool is_hit = false;       // Whether the answer came from the cache.
+  };
+
+  /// @brief An on-disk store of answers keyed by (day, part, solver build id, input hash). The store is a plain text file
+  /// with one entry per line, and new entries are appended as soon as they are computed. Answers may span several lines;
+  /// their line breaks are escaped in the file.
+  class ResultCache
+  {
+  private:
+    using Key = std::tuple<int, int, std::string, uint64_t>;
+
+    std::string file_name;
+    std::string build_id;
+    std::map<Key, CachedResult> entries;
+
+    /// @brief Replaces whitespace so that the build id stays a single token in the cache file.
+    static std::string sanitize(std::string str)
+    {
+      for (char &c : str)
+      {
+        if (std::isspace((unsigned char)c))
+          c = '_';
+      }
+      return str;
+    }
+
+    /// @brief Escapes backslashes and line breaks so that an answer stays on one line in the cache file.
+    static std::string escape(const std::string &str)
+    {
+      std::string escaped;
+      escaped.reserve(str.size());
+      for (char c : str)
+      {
+        switch (c)
+        {
+        case '\\':
+          escaped += "\\\\";
+          break;
+        case '\n':
+          escaped += "\\n";
+          break;
+        case '\r':
+          escaped += "\\r";
+          break;
+        default:
+          escaped += c;
+          break;
+        }
+      }
+      return escaped;
+    }
+
+    /// @brief Reverses `escape`.
+    static std::string unescape(const std::string &str)
+    {
+      std::string unescaped;
+      unescaped.reserve(str.size());
+      for (size_t i = 0; i < str.size(); i++)
+      {
+        if (str[i] == '\\' && i + 1 < str.size())
+        {
+          char escaped = str[++i];
+          unescaped += escaped == 'n' ? '\n' : escaped == 'r' ? '\r' : escaped;
+        }
+        else
+        {
+          unescaped += str[i];
+        }
+      }
+      return unescaped;
+    }
+
+  public:
+    ResultCache(const std::string &file_name = ".aoc_cache", const std::string &build_id = SOLVER_BUILD_ID)
+        : file_name(file_name), build_id(sanitize(build_id))
+    {
+      std::ifstream file_handle(file_name);
+      if (!file_handle.is_open())
+      {
+        return;
+      }
+
+      std::string current_line;
+      while (std::getline(file_handle, current_line))
+      {
+        std::istringstream tokens(current_line);
+        int day, part;
+        std::string entry_build_id;
+        uint64_t input_hash;
+        CachedResult result;
+        if (tokens >> day >> part >> entry_build_id >> std::hex >> input_hash >> std::dec >> result.nanoseconds >> std::ws && std::getline(tokens, result.answer))
+        {
+          result.answer = unescape(result.answer);
+          entries[Key(day, part, entry_build_id, input_hash)] = result;
+        }
+      }
+    }
+
+    /// @brief Looks up an answer.
+    /// @return A pointer to the cached result, or `nullptr` if there is none for the current build.
+    const CachedResult *find(int day, int part, uint64_t input_hash) const
+    {
+      auto entry = entries.find(Key(day, part, build_id, input_hash));
+      return entry == entries.end() ? nullptr : &entry->second;
+    }
+
+    /// @brief Records an answer, both in memory and on disk.
+    void store(int day, int part, uint64_t input_hash, const CachedResult &result)
+    {
+      entries[Key(day, part, build_id, input_hash)] = result;
+
+      std::ofstream file_handle(file_name, std::ios::app);
+      file_handle << day << " " << part << " " << build_id << " "
+                  << std::hex << std::setw(16) << std::setfill('0') << input_hash << std::dec << " "
+                  << result.nanoseconds << " " << escape(result.answer) << "\n";
+    }
+  };
+
+  /// @brief Gets the answer for an input from the cache if possible, and runs the solver otherwise.
+  /// @param cache The result cache.
+  /// @param day The day being solved.
+  /// @param part The part being solved.
+  /// @param input_hash The hash of the input, from `hash_contents`.
+  /// @param solver Computes the answer, called as `solver()` and returning something printable.
+  /// @return The answer and how long it took to compute.
+  template <class Solver>
+  CachedResult cached_solve(ResultCache &cache, int day, int part, uint64_t input_hash, Solver solver)
+  {
+    if (const CachedResult *cached = cache.find(day, part, input_hash))
+    {
+      CachedResult result = *cached;
+      result.is_hit = true;
+      return result;
+    }
+
+    auto start = std::chrono::steady_clock::now();
+    std::ostringstream answer;
+    answer << solver();
+    auto end = std::chrono::steady_clock::now();
+
+    CachedResult result;
+    result.answer = answer.str();
+    result.nanoseconds = std::chrono::duration_cast<std::chrono::nanoseconds>(end - start).count();
+    cache.store(day, part, input_hash, result);
+    return result;
+  }
+
+  /// @brief Gets the answer for an input file from the cache if possible, and runs the solver otherwise.
+  /// The input is hashed straight from its memory mapping before anything is parsed.
+  /// @param file_name The input file.
+  /// @return The answer and how long it took to compute.
+  template <class Solver>
+  CachedResult cached_solve(ResultCache &cache, int day, int part, const std::string &file_name, Solver solver)
+  {
+    uint64_t input_hash;
+    {
+      MappedFile input(file_name);
+      input_hash = hash_contents(input.view());
+    }
+    return cached_solve(cache, day, part, input_hash, solver);
+  }
+}
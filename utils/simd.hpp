@@ -0,0 +1,107 @@
+#pragma once
+#include <bit>
+#include <cstdint>
+#include <cstring>
+#include <string_view>
+
+#if defined(__AVX2__) || defined(__SSE2__)
+#include <immintrin.h>
+#endif
+
+namespace utils
+{
+  const size_t SIMD_BLOCK_SIZE = 64;
+
+  /// @brief Finds every occurrence of a byte in a 64-byte block.
+  /// Uses AVX2 or SSE2 compares when the compiler targets them, and a loop the compiler can vectorize otherwise.
+  /// @param block The block. All `SIMD_BLOCK_SIZE` bytes must be readable.
+  /// @param byte The byte to look for.
+  /// @return A mask with bit `i` set if `block[i] == byte`.
+  uint64_t find_byte_mask(const char *block, char byte)
+  {
+#if defined(__AVX2__)
+    __m256i needle = _mm256_set1_epi8(byte);
+    uint64_t low = (uint32_t)_mm256_movemask_epi8(_mm256_cmpeq_epi8(_mm256_loadu_si256((const __m256i *)block), needle));
+    uint64_t high = (uint32_t)_mm256_movemask_epi8(_mm256_cmpeq_epi8(_mm256_loadu_si256((const __m256i *)(block + 32)), needle));
+    return low | (high << 32);
+#elif defined(__SSE2__)
+    __m128i needle = _mm_set1_epi8(byte);
+    uint64_t mask = 0;
+    for (size_t i = 0; i < SIMD_BLOCK_SIZE; i += 16)
+    {
+      uint64_t part = (uint16_t)_mm_movemask_epi8(_mm_cmpeq_epi8(_mm_loadu_si128((const __m128i *)(block + i)), needle));
+      mask |= part << i;
+    }
+    return mask;
+#else
+    uint64_t mask = 0;
+    for (size_t i = 0; i < SIMD_BLOCK_SIZE; i++)
+    {
+      mask |= (uint64_t)(block[i] == byte) << i;
+    }
+    return mask;
+#endif
+  }
+
+  /// @brief Converts a run of up to 8 decimal digits to a number with a handful of 64-bit multiplies instead of one per digit.
+  /// Assumes a little-endian target.
+  /// @param digits The digits. If fewer than 8 bytes are readable from here, the caller must pass a padded copy.
+  /// @param length The number of digits, from 1 to 8. The bytes after them are ignored.
+  /// @return The number.
+  uint32_t parse_digits_swar(const char *digits, size_t length)
+  {
+    uint64_t word;
+    std::memcpy(&word, digits, sizeof(word));
+    // Any borrow out of a non-digit byte only moves towards the higher bytes, which the shift then drops.
+    word -= 0x3030303030303030ull;
+    word <<= (8 - length) * 8; // Right-aligns the digits, so that the missing leading digits are zeroes.
+
+    word = (word * 10 + (word >> 8)) & 0x00FF00FF00FF00FFull;
+    word = (word * 100 + (word >> 16)) & 0x0000FFFF0000FFFFull;
+    word = (word * 10000 + (word >> 32)) & 0x00000000FFFFFFFFull;
+    return (uint32_t)word;
+  }
+
+  /// @brief Calls a function on every line of a block of text, finding the line breaks 64 bytes at a time with `find_byte_mask`.
+  /// Handles both LF and CRLF line endings, like `next_line`.
+  /// @param text The text.
+  /// @param visit Called as `visit(line)` for each line in order, without its line ending. Text after the last line break counts
+  /// as a line if there is any.
+  template <class Visit>
+  void for_each_line(std::string_view text, Visit visit)
+  {
+    size_t line_start = 0;
+    auto visit_line = [&](size_t line_end)
+    {
+      std::string_view line = text.substr(line_start, line_end - line_start);
+      if (!line.empty() && line.back() == '\r')
+      {
+        line.remove_suffix(1);
+      }
+      visit(line);
+      line_start = line_end + 1;
+    };
+
+    size_t block = 0;
+    for (; block + SIMD_BLOCK_SIZE <= text.size(); block += SIMD_BLOCK_SIZE)
+    {
+      uint64_t newlines = find_byte_mask(text.data() + block, '\n');
+      while (newlines != 0)
+      {
+        visit_line(block + std::countr_zero(newlines));
+        newlines &= newlines - 1;
+      }
+    }
+    for (; block < text.size(); block++)
+    {
+      if (text[block] == '\n')
+      {
+        visit_line(block);
+      }
+    }
+    if (line_start < text.size())
+    {
+      visit_line(text.size());
+    }
+  }
+}
@@ -0,0 +1,220 @@
+#pragma once
+#include <algorithm>
+#include <initializer_list>
+#include <memory>
+#include <new>
+#include <type_traits>
+#include <stdexcept>
+#include <utility>
+
+namespace utils
+{
+  /// @brief A vector that keeps its first `N` elements inside the object itself, and only allocates once it outgrows them.
+  /// Meant for the many small lists (directory children, subpackets, held items) that would otherwise each cost a heap allocation.
+  template <class T, size_t N>
+  class SmallVector
+  {
+    static_assert(N > 0, "SmallVector needs at least one inline element.");
+
+  private:
+    alignas(T) unsigned char inline_storage[N * sizeof(T)];
+    T *elements = reinterpret_cast<T *>(inline_storage);
+    size_t num_elements = 0;
+    size_t max_elements = N;
+
+    bool is_inline() const
+    {
+      return elements == reinterpret_cast<const T *>(inline_storage);
+    }
+
+    /// @brief Moves the elements into a larger heap allocation.
+    /// @param min_elements The least number of elements the new allocation must hold.
+    void grow(size_t min_elements)
+    {
+      size_t new_max_elements = std::max(max_elements * 2, min_elements);
+      T *new_elements = std::allocator<T>().allocate(new_max_elements);
+      std::uninitialized_move(elements, elements + num_elements, new_elements);
+      std::destroy(elements, elements + num_elements);
+      release();
+      elements = new_elements;
+      max_elements = new_max_elements;
+    }
+
+    /// @brief Frees the heap allocation, if any. The elements must already be destroyed.
+    void release()
+    {
+      if (!is_inline())
+      {
+        std::allocator<T>().deallocate(elements, max_elements);
+      }
+      elements = reinterpret_cast<T *>(inline_storage);
+      max_elements = N;
+    }
+
+  public:
+    SmallVector()
+    {
+    }
+
+    template <class Iterator>
+    SmallVector(Iterator first, Iterator last)
+    {
+      for (; first != last; ++first)
+      {
+        emplace_back(*first);
+      }
+    }
+
+    SmallVector(std::initializer_list<T> values) : SmallVector(values.begin(), values.end())
+    {
+    }
+
+    SmallVector(const SmallVector &other) : SmallVector(other.begin(), other.end())
+    {
+    }
+
+    SmallVector(SmallVector &&other) noexcept(std::is_nothrow_move_constructible<T>::value)
+    {
+      *this = std::move(other);
+    }
+
+    SmallVector &operator=(const SmallVector &other)
+    {
+      if (this != &other)
+      {
+        clear();
+        reserve(other.size());
+        for (const T &value : other)
+        {
+          emplace_back(value);
+        }
+      }
+      return *this;
+    }
+
+    SmallVector &operator=(SmallVector &&other) noexcept(std::is_nothrow_move_constructible<T>::value)
+    {
+      if (this == &other)
+      {
+        return *this;
+      }
+      clear();
+      release();
+      if (other.is_inline())
+      {
+        std::uninitialized_move(other.begin(), other.end(), elements);
+        num_elements = other.num_elements;
+        other.clear();
+      }
+      else // Steal the heap allocation.
+      {
+        elements = std::exchange(other.elements, reinterpret_cast<T *>(other.inline_storage));
+        num_elements = std::exchange(other.num_elements, 0);
+        max_elements = std::exchange(other.max_elements, N);
+      }
+      return *this;
+    }
+
+    ~SmallVector()
+    {
+      clear();
+      release();
+    }
+
+    template <class... Args>
+    T &emplace_back(Args &&...args)
+    {
+      if (num_elements == max_elements)
+      {
+        // Construct first, in case the arguments refer to an element that `grow` would move.
+        T value(std::forward<Args>(args)...);
+        grow(num_elements + 1);
+        return *new (elements + num_elements++) T(std::move(value));
+      }
+      return *new (elements + num_elements++) T(std::forward<Args>(args)...);
+    }
+
+    void push_back(const T &value)
+    {
+      emplace_back(value);
+    }
+
+    void push_back(T &&value)
+    {
+      emplace_back(std::move(value));
+    }
+
+    void pop_back()
+    {
+      if (empty())
+      {
+        throw std::underflow_error("SmallVector is empty.");
+      }
+      std::destroy_at(elements + --num_elements);
+    }
+
+    void clear()
+    {
+      std::destroy(elements, elements + num_elements);
+      num_elements = 0;
+    }
+
+    void reserve(size_t min_elements)
+    {
+      if (min_elements > max_elements)
+      {
+        grow(min_elements);
+      }
+    }
+
+    size_t size() const
+    {
+      return num_elements;
+    }
+
+    bool empty() const
+    {
+      return num_elements == 0;
+    }
+
+    T &operator[](size_t i)
+    {
+      return elements[i];
+    }
+
+    const T &operator[](size_t i) const
+    {
+      return elements[i];
+    }
+
+    T &front()
+    {
+      return elements[0];
+    }
+
+    T &back()
+    {
+      return elements[num_elements - 1];
+    }
+
+    T *begin()
+    {
+      return elements;
+    }
+
+    T *end()
+    {
+      return elements + num_elements;
+    }
+
+    const T *begin() const
+    {
+      return elements;
+    }
+
+    const T *end() const
+    {
+      return elements + num_elements;
+    }
+  };
+}
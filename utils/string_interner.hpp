@@ -0,0 +1,71 @@
+#pragma once
+#include <cstdint>
+#include <deque>
+#include <mutex>
+#include <shared_mutex>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+
+namespace utils
+{
+  /// @brief A thread-safe pool of unique strings. Each distinct string is stored once and identified by a compact id,
+  /// and the views it hands out stay valid for as long as the pool exists.
+  class StringInterner
+  {
+  private:
+    std::deque<std::string> strings; // A deque, so that existing strings never move when new ones are added.
+    std::unordered_map<std::string_view, uint32_t> ids;
+    mutable std::shared_mutex mutex;
+
+  public:
+    /// @brief Adds a string to the pool if it is not there yet.
+    /// @param str The string.
+    /// @return The id of the string.
+    uint32_t intern(std::string_view str)
+    {
+      {
+        std::shared_lock<std::shared_mutex> lock(mutex);
+        auto existing = ids.find(str);
+        if (existing != ids.end())
+        {
+          return existing->second;
+        }
+      }
+
+      std::unique_lock<std::shared_mutex> lock(mutex);
+      auto existing = ids.find(str); // Another thread may have added it in the meantime.
+      if (existing != ids.end())
+      {
+        return existing->second;
+      }
+      uint32_t id = (uint32_t)strings.size();
+      strings.emplace_back(str);
+      ids.emplace(strings.back(), id);
+      return id;
+    }
+
+    /// @brief Adds a string to the pool if it is not there yet.
+    /// @param str The string.
+    /// @return A view of the pooled copy of the string.
+    std::string_view intern_view(std::string_view str)
+    {
+      return lookup(intern(str));
+    }
+
+    /// @brief Gets an interned string.
+    /// @param id The id of the string.
+    /// @return A view of the string.
+    std::string_view lookup(uint32_t id) const
+    {
+      std::shared_lock<std::shared_mutex> lock(mutex);
+      return strings.at(id);
+    }
+
+    size_t size() const
+    {
+      std::shared_lock<std::shared_mutex> lock(mutex);
+      return strings.size();
+    }
+  };
+}
@@ -0,0 +1,92 @@
+#pragma once
+#include <string_view>
+#include <vector>
+#include <algorithm>
+
+namespace utils
+{
+  const size_t MIN_CHUNK_BYTES = 1 << 16; // Smaller chunks are not worth a thread of their own.
+
+  /// @brief Takes the next line from a block of text. Handles both LF and CRLF line endings.
+  /// @param text The remaining text. The line and its line ending are removed from the front.
+  /// @return The line, without its line ending.
+  constexpr std::string_view next_line(std::string_view &text)
+  {
+    size_t end = text.find('\n');
+    std::string_view line = text.substr(0, end);
+    text.remove_prefix(end == std::string_view::npos ? text.size() : end + 1);
+    if (!line.empty() && line.back() == '\r')
+    {
+      line.remove_suffix(1);
+    }
+    return line;
+  }
+
+  constexpr bool is_digit(char c)
+  {
+    return c >= '0' && c <= '9';
+  }
+
+  /// @brief Parses an unsigned decimal number without allocating or throwing.
+  /// @param text The text to parse.
+  /// @param i The index to start at. Advanced past the digits.
+  /// @return The parsed number, or 0 if there are no digits at `i`.
+  constexpr unsigned long long parse_unsigned(std::string_view text, size_t &i)
+  {
+    unsigned long long value = 0;
+    for (; i < text.size() && is_digit(text[i]); i++)
+    {
+      value = value * 10 + (text[i] - '0');
+    }
+    return value;
+  }
+
+  /// @brief Parses a (possibly negative) decimal number without allocating or throwing.
+  /// @param text The text to parse.
+  /// @param i The index to start at. Advanced past the sign and digits.
+  /// @return The parsed number.
+  constexpr long long parse_signed(std::string_view text, size_t &i)
+  {
+    bool is_negative = i < text.size() && text[i] == '-';
+    if (is_negative)
+    {
+      i++;
+    }
+    long long magnitude = (long long)parse_unsigned(text, i);
+    return is_negative ? -magnitude : magnitude;
+  }
+
+  /// @brief Picks how many chunks to split a block of text into, so that every thread gets one but no chunk is smaller than
+  /// `MIN_CHUNK_BYTES`.
+  /// @param num_bytes The size of the text.
+  /// @param num_threads The most threads to use.
+  /// @return The number of chunks, at least 1.
+  size_t get_chunk_count(size_t num_bytes, size_t num_threads)
+  {
+    return std::max<size_t>(1, std::min(num_threads, num_bytes / MIN_CHUNK_BYTES));
+  }
+
+  /// @brief Splits a block of text into roughly equal chunks that each start at the beginning of a line, so that the chunks can
+  /// be scanned independently.
+  /// @param text The text.
+  /// @param num_chunks The number of chunks. Some may be empty if the lines are long.
+  /// @return The chunks, in order. Together they cover the whole text.
+  std::vector<std::string_view> split_into_line_chunks(std::string_view text, size_t num_chunks)
+  {
+    std::vector<std::string_view> chunks;
+    size_t begin = 0;
+    for (size_t i = 1; i <= num_chunks; i++)
+    {
+      size_t end = text.size();
+      if (i < num_chunks)
+      {
+        end = std::max(begin, text.size() / num_chunks * i);
+        end = text.find('\n', end);
+        end = end == std::string_view::npos ? text.size() : end + 1;
+      }
+      chunks.emplace_back(text.substr(begin, end - begin));
+      begin = end;
+    }
+    return chunks;
+  }
+}